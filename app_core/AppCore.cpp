@@ -7,6 +7,7 @@
 #include "i128.hpp"
 
 #include <QSettings>
+#include <array>
 #include <memory>
 #include <QDebug>
 #include <QTimer>
@@ -22,6 +23,16 @@ namespace modifiers {
     static const auto reset   = "\033[0m";    // Обязательный сброс в конце строки
 }
 
+/**
+ * @brief Десятичная запись числа (U128, I128, Decimal) в QString через to_chars, без промежуточного std::string.
+ */
+template <typename T>
+static QString to_qstring(const T& value) {
+    char buffer[dec_n::Vector128::MaxSize()];
+    const auto [end, ec] = to_chars(std::begin(buffer), std::end(buffer), value);
+    return QString::fromLatin1(buffer, static_cast<int>(end - buffer));
+}
+
 /**
  * @brief Возвращает описание ошибки по коду ошибки.
  */
@@ -154,7 +165,8 @@ void AppCore::DoWork(dec_n::Decimal value, int operation)
 
         // Аргументы операции (если это не рандом)
         if (operation != OperationEnums::RANDINT && operation != OperationEnums::RANDINT64) {
-            auto sv1 = mRegister[1].ValueAsStringView();
+            const auto x_text = mRegister[1].ValueAsStringView();
+            std::string_view sv1 = x_text;
             if (operation == OperationEnums::FACTOR) { // Для факторизации нет смысла выводить дробную часть.
                 // Ищем позицию первого вхождения точки или запятой
                 size_t pos = sv1.find_first_of(".,");
@@ -180,7 +192,7 @@ void AppCore::DoWork(dec_n::Decimal value, int operation)
     QVector<dec_n::Decimal> request_vector { mRegister[1], mRegister[0] };
 
     m_reqFree.acquire();
-    m_requests[mRequestIdx] = { operation, request_vector };
+    m_requests[mRequestIdx] = { operation, request_vector, dec_n::DecimalContext::Current() };
     m_reqUsed.release();
 }
 
@@ -215,7 +227,7 @@ void AppCore::process(int requested_operation, QString input_value)
         bignum::u128::U128 value = (requested_operation == OperationEnums::MAX_INT_VALUE)
         ? bignum::u128::U128::max() : bignum::u128::U128{0};
         if (mState == StateEnums::RESETTED) emit clearTempResult();
-        emit setInput(QString::fromStdString(value.toString()));
+        emit setInput(to_qstring(value));
         return;
     }
 
@@ -230,7 +242,14 @@ void AppCore::process(int requested_operation, QString input_value)
     // --- 4. Парсинг числа ---
     input_value.remove(QRegularExpression{"\\s"});
     dec_n::Decimal val;
-    val.SetStringRepresentation(input_value.toStdString());
+    {
+        // Копия ввода на стеке: лишние символы все равно отбрасываются буфером Decimal.
+        std::array<char, dec_n::Vector128::MaxSize()> input_chars;
+        const int input_length = std::min(static_cast<int>(input_value.size()), dec_n::Vector128::MaxSize());
+        for (int i = 0; i < input_length; ++i)
+            input_chars[i] = input_value[i].toLatin1();
+        val.SetStringRepresentation({input_chars.data(), static_cast<size_t>(input_length)});
+    }
 
     if (val.IsOverflowed()) {
         updateUIWithError(Errors::NOT_FINITE);
@@ -399,8 +418,8 @@ void AppCore::handle_results_queue(int err, int operation, bool exact_sqrt, QVec
 
         QStringList factors;
         for (int i = 0; i + 1 < res.size(); i += 2) {
-            QString prime = QString::fromStdString(res[i].IntegerPart().toString());
-            QString power = QString::fromStdString(res[i + 1].IntegerPart().unsigned_part().toString());
+            QString prime = to_qstring(res[i].IntegerPart());
+            QString power = to_qstring(res[i + 1].IntegerPart().unsigned_part());
             factors << QString("%1^%2").arg(prime, power);
         }
 
@@ -445,7 +464,6 @@ void AppCore::handle_results_queue(int err, int operation, bool exact_sqrt, QVec
 void AppCore::change_decimal_width(int width, bool quiet)
 {
     const bool is_changed = dec_n::Decimal::SetWidth(width);
-    emit m_controller.sync_decimal_width(width);
     if (is_changed) {
         Reset();
         emit clearTempResult();
@@ -12,6 +12,7 @@
 namespace dec_n { class Decimal; }
 
 Q_DECLARE_METATYPE(dec_n::Decimal);
+Q_DECLARE_METATYPE(dec_n::DecimalContext);
 
 inline std::mutex g_console_output_mutex;
 
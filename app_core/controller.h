@@ -36,18 +36,13 @@ signals:
     /**
      * @brief Сигнализирует "Работнику" о запросе на выполнение.
      */
-    void operate(int, QVector<dec_n::Decimal>);
+    void operate(int, QVector<dec_n::Decimal>, dec_n::DecimalContext);
 
     /**
      * @brief Сигнализирует "Наблюдателю" приложения о готовности результата.
      */
     void handle_results(int, int, bool, QVector<dec_n::Decimal>);
 
-    /**
-     * @brief Сигнал синхронизации количества знаков после запятой для Decimal в пространстве библиотеки.
-     */
-    void sync_decimal_width(int);
-
     /**
      * @brief Остановить текущее вычисление разово.
      */
@@ -2,10 +2,20 @@
 #include <QQmlApplicationEngine>
 
 #include "AppCore.h"
+#include "scaled_decimal.h"
+#include "decimal_math.h"
+#include "decimal_wire.h"
+#include "calculus.h"
+#include "expression.h"
+#include "prime_range.h"
+#include "u128_array.h"
 #include <QQmlContext>
 #include <QSettings>
 #include <QTimer>
 #include <cassert>
+#include <chrono>
+#include <random>
+#include <thread>
 
 
 using namespace dec_n;
@@ -16,6 +26,15 @@ static void run_unit_tests() {
 
     using namespace bignum::i128;
 
+    // Наибольший модуль целой части Decimal: у S128 (DECIMAL_S128) он на бит короче, чем у I128.
+#if defined(DECIMAL_S128)
+    const U128 max_int = (U128::max() >> 1) - U128{1};
+#else
+    const U128 max_int = U128::max();
+#endif
+    // Половина max_int в записи с тремя знаками после запятой.
+    const std::string half_max_int = (max_int >> 1).toString() + ((max_int.low() & 1) ? ",500" : ",000");
+
     { // max_int / 10
         I128 x = U128::max();
         const auto [q, _] = x / 10ull;
@@ -72,7 +91,7 @@ static void run_unit_tests() {
     }
 
     { // max_int * 1,00...01
-        Decimal d1; d1.SetDecimal(U128::max(), I128{0} );
+        Decimal d1; d1.SetDecimal(max_int, I128{0} );
         Decimal d2; d2.SetDecimal(I128{1}, I128{1} );
         assert(d2.GetWidth() > 0);
         const auto z = d1 * d2;
@@ -81,65 +100,65 @@ static void run_unit_tests() {
     }
 
     { // max_int * 0,5
-        Decimal d1; d1.SetDecimal(U128::max(), I128{0} );
+        Decimal d1; d1.SetDecimal(max_int, I128{0} );
         Decimal d2; d2.SetDecimal(I128{0}, I128{1}, I128{2} );
         assert(d2.GetWidth() > 0);
         const auto z = d1 * d2;
         all_is_ok &= !z.IsOverflowed();
         all_is_ok &= d2.ValueAsStringView().starts_with("0,5");
-        all_is_ok &= z.ValueAsStringView().starts_with("170141183460469231731687303715884105727");
+        all_is_ok &= z.ValueAsStringView().starts_with((max_int >> 1).toString());
         assert(all_is_ok);
     }
 
     { // 0,5 * max_int
-        Decimal d1; d1.SetDecimal(U128::max(), I128{0} );
+        Decimal d1; d1.SetDecimal(max_int, I128{0} );
         Decimal d2; d2.SetDecimal(I128{0}, I128{1}, I128{2} );
         assert(d2.GetWidth() > 0);
         const auto z = d2 * d1;
         all_is_ok &= !z.IsOverflowed();
         all_is_ok &= d2.ValueAsStringView().starts_with("0,5");
-        all_is_ok &= z.ValueAsStringView().starts_with("170141183460469231731687303715884105727");
+        all_is_ok &= z.ValueAsStringView().starts_with((max_int >> 1).toString());
         assert(all_is_ok);
     }
 
     { // max_int / 1,999: correct all 9's to all 0's with corresponding integer part adjusting.
-        Decimal d1; d1.SetDecimal(U128::max(), I128{0} );
+        Decimal d1; d1.SetDecimal(max_int, I128{0} );
         Decimal d2; d2.SetDecimal(I128{1},  I128{999} );
         const auto z = d1 / d2;
         all_is_ok &= !z.IsOverflowed();
-        all_is_ok &= z.ValueAsStringView().starts_with("170141183460469231731687303715884105727,500");
+        all_is_ok &= z.ValueAsStringView().starts_with(half_max_int);
         assert(all_is_ok);
     }
 
     { // max_int / -1,999
-        Decimal d1; d1.SetDecimal(U128::max(), I128{0} );
+        Decimal d1; d1.SetDecimal(max_int, I128{0} );
         Decimal d2; d2.SetDecimal(-I128{1},  I128{999} );
         const auto z = d1 / d2;
         all_is_ok &= !z.IsOverflowed();
-        all_is_ok &= z.ValueAsStringView().starts_with("-170141183460469231731687303715884105727,500");
+        all_is_ok &= z.ValueAsStringView().starts_with("-" + half_max_int);
         assert(all_is_ok);
     }
 
     { // -max_int / 1,999
-        Decimal d1; d1.SetDecimal(-I128{U128::max()}, I128{0} );
+        Decimal d1; d1.SetDecimal(-I128{max_int}, I128{0} );
         Decimal d2; d2.SetDecimal(I128{1},  I128{999} );
         const auto z = d1 / d2;
         all_is_ok &= !z.IsOverflowed();
-        all_is_ok &= z.ValueAsStringView().starts_with("-170141183460469231731687303715884105727,500");
+        all_is_ok &= z.ValueAsStringView().starts_with("-" + half_max_int);
         assert(all_is_ok);
     }
 
     { // -max_int / -1,999
-        Decimal d1; d1.SetDecimal(-I128{U128::max()}, I128{0} );
+        Decimal d1; d1.SetDecimal(-I128{max_int}, I128{0} );
         Decimal d2; d2.SetDecimal(-I128{1},  I128{999} );
         const auto z = d1 / d2;
         all_is_ok &= !z.IsOverflowed();
-        all_is_ok &= z.ValueAsStringView().starts_with("170141183460469231731687303715884105727,500");
+        all_is_ok &= z.ValueAsStringView().starts_with(half_max_int);
         assert(all_is_ok);
     }
 
     { // (max_int / 1,9) * 1,9
-        Decimal d1; d1.SetDecimal(U128::max(), I128{0} );
+        Decimal d1; d1.SetDecimal(max_int, I128{0} );
         Decimal d2; d2.SetDecimal(I128{1},  I128{900} );
         auto z = d1 / d2;
         z = z * d2;
@@ -150,7 +169,7 @@ static void run_unit_tests() {
     }
 
     { // (max_int * 0,9) / 0,9
-        Decimal d1; d1.SetDecimal(U128::max(), I128{0} );
+        Decimal d1; d1.SetDecimal(max_int, I128{0} );
         Decimal d2; d2.SetDecimal(I128{0},  I128{900} );
         auto z = d1 * d2;
         z = z / d2;
@@ -161,7 +180,7 @@ static void run_unit_tests() {
     }
 
     { // max_int / 0,999
-        Decimal d1; d1.SetDecimal(U128::max(), I128{0} );
+        Decimal d1; d1.SetDecimal(max_int, I128{0} );
         Decimal d2; d2.SetDecimal(I128{0},  I128{999} );
         const auto z = d1 / d2;
         all_is_ok &= !z.IsOverflowed();
@@ -169,7 +188,7 @@ static void run_unit_tests() {
     }
 
     { // -max_int / 0,999
-        Decimal d1; d1.SetDecimal(-I128{U128::max()}, I128{0} );
+        Decimal d1; d1.SetDecimal(-I128{max_int}, I128{0} );
         Decimal d2; d2.SetDecimal(I128{0},  I128{999} );
         const auto z = d1 / d2;
         all_is_ok &= !z.IsOverflowed();
@@ -177,7 +196,7 @@ static void run_unit_tests() {
     }
 
     { // -max_int / -0,999
-        Decimal d1; d1.SetDecimal(-I128{U128::max()}, I128{0} );
+        Decimal d1; d1.SetDecimal(-I128{max_int}, I128{0} );
         Decimal d2; d2.SetDecimal(I128{0},  I128{999} );
         const auto z = d1 / -d2;
         all_is_ok &= !z.IsOverflowed();
@@ -185,7 +204,7 @@ static void run_unit_tests() {
     }
 
     { // max_int,999 + 0,001
-        Decimal d1; d1.SetDecimal(U128::max(), I128{999} );
+        Decimal d1; d1.SetDecimal(max_int, I128{999} );
         Decimal d2; d2.SetDecimal(I128{0}, I128{1} );
         const auto z = d1 + d2;
         all_is_ok &= z.IsOverflowed();
@@ -193,7 +212,7 @@ static void run_unit_tests() {
     }
 
     { // -max_int,999 - 0,001
-        Decimal d1; d1.SetDecimal(-I128{U128::max()}, I128{999} );
+        Decimal d1; d1.SetDecimal(-I128{max_int}, I128{999} );
         Decimal d2; d2.SetDecimal(I128{0}, I128{1} );
         const auto z = d1 - d2;
         all_is_ok &= z.IsOverflowed();
@@ -201,7 +220,7 @@ static void run_unit_tests() {
     }
 
     { // max_int,999 + 0,000
-        Decimal d1; d1.SetDecimal(U128::max(), I128{999} );
+        Decimal d1; d1.SetDecimal(max_int, I128{999} );
         Decimal d2; d2.SetDecimal(I128{0}, I128{0} );
         const auto z = d1 + d2;
         all_is_ok &= z.IsOverflowed();
@@ -209,7 +228,7 @@ static void run_unit_tests() {
     }
 
     { // -max_int,999 - 0,000
-        Decimal d1; d1.SetDecimal(-I128{U128::max()}, I128{999} );
+        Decimal d1; d1.SetDecimal(-I128{max_int}, I128{999} );
         Decimal d2; d2.SetDecimal(I128{0}, I128{0} );
         const auto z = d1 - d2;
         all_is_ok &= z.IsOverflowed();
@@ -321,6 +340,289 @@ static void run_unit_tests() {
         const auto& y = Sqrt(two, exact);
         assert(y.GetWidth() == 3);
         all_is_ok &= y.ValueAsStringView() == "1,414";
+        all_is_ok &= !exact;
+        assert(all_is_ok);
+    }
+
+    {
+        Decimal x; x.SetStringRepresentation("1,44");
+        bool exact;
+        const auto& y = Sqrt(x, exact);
+        all_is_ok &= y.ValueAsStringView() == "1,200";
+        all_is_ok &= exact;
+        assert(all_is_ok);
+    }
+
+    {
+        Decimal::SetWidth(1);
+        Decimal x; x.SetStringRepresentation("1,5");
+        Decimal::SetWidth(3);
+        Decimal y; y.SetStringRepresentation("1,500");
+        Decimal z; z.SetStringRepresentation("-1,501");
+        Decimal inf; inf.SetInfinity();
+        all_is_ok &= x == y && std::hash<Decimal>{}(x) == std::hash<Decimal>{}(y); // Ширина не влияет на значение.
+        all_is_ok &= Decimal{} < z && z < x && x < inf;
+        assert(all_is_ok);
+    }
+
+    {
+        Decimal x; x.SetStringRepresentation("0,015");
+        Decimal y; y.SetStringRepresentation("0,5");
+        const std::array<Decimal, 4> xs{x, x, x, x};
+        const std::array<Decimal, 4> ys{y, y, y, y};
+        all_is_ok &= Dot(xs, ys).ValueAsStringView() == "0,030"; // Цепочка x*y + ... дает 4 * 0,007 = 0,028.
+        all_is_ok &= Fma(x, y, x).ValueAsStringView() == "0,022";
+        Decimal big; big.SetDecimal(max_int, I128{0});
+        all_is_ok &= Fma(big, big, x).IsOverflowed();
+        assert(all_is_ok);
+    }
+
+    {
+        const DecimalContext context{2};
+        const DecimalContext::Scope scope{context}; // Операнды - в той же ширине, что и операция.
+        Decimal a; a.SetStringRepresentation("19,95");
+        Decimal b; b.SetStringRepresentation("3");
+        Decimal zero; zero.SetZero();
+        const std::array<Decimal, 3> x{a, a, b};
+        const std::array<Decimal, 3> y{b, zero, a};
+        std::array<Decimal, 3> out;
+        std::array<int, 3> errors;
+        doItBatch(context, calculus::DIV, x, y, out, errors);
+        all_is_ok &= out[0].ValueAsStringView() == "6,65" && errors[0] == calculus::NO_ERRORS;
+        all_is_ok &= errors[1] == calculus::ZERO_DIVISION;
+        all_is_ok &= out[2].ValueAsStringView() == "0,15";
+        doItBatchParallel(context, calculus::MULT, x, y, out, errors);
+        all_is_ok &= out[0].ValueAsStringView() == "59,85" && out[2].ValueAsStringView() == "59,85";
+        assert(all_is_ok);
+    }
+
+    {
+        const DecimalContext context{2};
+        const auto& expression = calculus::Expression::Compile("price * qty * (1 - 0,5 / 10)", context);
+        all_is_ok &= expression && expression->Variables().size() == 2 && expression->VariableIndex("qty") == 1;
+        all_is_ok &= expression->Size() == 5; // (1 - 0,5 / 10) свернуто в константу 0,95.
+        const DecimalContext::Scope scope{context};
+        std::array<Decimal, 4> values;
+        values[0].SetStringRepresentation("19,95"); values[1].SetStringRepresentation("3");
+        values[2].SetStringRepresentation("10"); values[3].SetZero();
+        std::array<Decimal, 2> out;
+        std::array<int, 2> errors;
+        expression->EvaluateBatch(values, out, errors);
+        all_is_ok &= out[0].ValueAsStringView() == "56,85" && errors[0] == calculus::NO_ERRORS;
+        all_is_ok &= out[1].IsZero();
+        int error;
+        all_is_ok &= calculus::Expression::Compile("1 / x", context)->Evaluate(std::span{values}.last(1), error).IsNotANumber();
+        all_is_ok &= error == calculus::ZERO_DIVISION;
+        size_t position;
+        all_is_ok &= !calculus::Expression::Compile("sqrt(2", context, &position) && position == 6;
+        assert(all_is_ok);
+    }
+
+    {
+        Decimal one; one.SetDecimal(I128{1}, I128{0});
+        Decimal x; x.SetStringRepresentation("1,5");
+        Decimal two; two.SetDecimal(I128{2}, I128{0});
+        all_is_ok &= Exp(one).ValueAsStringView() == "2,718";
+        all_is_ok &= Ln(one).IsZero() && Ln(-one).IsNotANumber();
+        all_is_ok &= Pow(x, two).ValueAsStringView() == "2,250"; // Точный результат не теряет младшую цифру.
+        all_is_ok &= Sin(x).ValueAsStringView() == "0,997" && Cos(x).ValueAsStringView() == "0,070";
+        all_is_ok &= Atan(-one).ValueAsStringView() == "-0,785";
+        assert(all_is_ok);
+    }
+    {
+        DecimalContext context{3, RoundingMode::HALF_EVEN};
+        const DecimalContext::Scope scope{context};
+        Decimal one; one.SetDecimal(I128{1}, I128{0});
+        Decimal two; two.SetDecimal(I128{2}, I128{0});
+        Decimal x; x.SetStringRepresentation("0,01");
+        Decimal y; y.SetStringRepresentation("-40");
+        all_is_ok &= Exp(one).ValueAsStringView() == "2,718" && Atan(-one).ValueAsStringView() == "-0,785";
+        all_is_ok &= Cos(x).ValueAsStringView() == "1,000" && Exp(y).ValueAsStringView() == "0,000"; // 0,99995 -> 1,000.
+        context.SetRounding(RoundingMode::FLOOR);
+        all_is_ok &= Atan(-one).ValueAsStringView() == "-0,786" && Cos(x).ValueAsStringView() == "0,999";
+        context.SetRounding(RoundingMode::CEILING);
+        all_is_ok &= Exp(one).ValueAsStringView() == "2,719" && Ln(two).ValueAsStringView() == "0,694";
+        all_is_ok &= Exp(y).ValueAsStringView() == "0,001"; // Исчезающе малый результат округляется вверх до 1 ulp.
+        Decimal zero; zero.SetDecimal(I128{0}, I128{0});
+        all_is_ok &= Exp(zero).ValueAsStringView() == "1,000"; // Точный результат не округляется.
+        DecimalContext narrow{1, RoundingMode::HALF_EVEN};
+        const DecimalContext::Scope narrow_scope{narrow};
+        Decimal z; z.SetStringRepresentation("1,5");
+        Decimal two_narrow; two_narrow.SetDecimal(I128{2}, I128{0});
+        all_is_ok &= Pow(z, two_narrow).ValueAsStringView() == "2,2"; // 2,25: половина - к четному.
+        narrow.SetRounding(RoundingMode::HALF_UP);
+        all_is_ok &= Pow(z, two_narrow).ValueAsStringView() == "2,3";
+        assert(all_is_ok);
+    }
+    {
+        Decimal x; x.SetStringRepresentation("-0,907");
+        Decimal y; y.SetStringRepresentation("-0,680");
+        all_is_ok &= (x + y).ValueAsStringView() == "-1,587";
+        DecimalContext context{2, RoundingMode::HALF_EVEN};
+        const DecimalContext::Scope scope{context};
+        x.SetStringRepresentation("2,345");
+        y.SetStringRepresentation("2,355");
+        all_is_ok &= x.ValueAsStringView() == "2,34" && y.ValueAsStringView() == "2,36";
+        Decimal half; half.SetStringRepresentation("0,5");
+        Decimal z; z.SetStringRepresentation("2,45");
+        all_is_ok &= (z * half).ValueAsStringView() == "1,22" && (y * half).ValueAsStringView() == "1,18";
+        all_is_ok &= y.Rounded(1).ValueAsStringView() == "2,40" && x.Rounded(0).ValueAsStringView() == "2,00";
+        context.SetRounding(RoundingMode::FLOOR);
+        x.SetStringRepresentation("-0,004");
+        all_is_ok &= x.ValueAsStringView() == "-0,01";
+        context.SetRounding(RoundingMode::CEILING);
+        Decimal three; three.SetDecimal(Integer{3}, Integer{0});
+        all_is_ok &= (half / three).ValueAsStringView() == "0,17";
+        assert(all_is_ok);
+    }
+    { // Rounded читает дробную часть в знаменателе самого числа, а не текущего контекста.
+        const DecimalContext narrow{3, RoundingMode::HALF_EVEN};
+        const DecimalContext wide{6, RoundingMode::HALF_UP};
+        Decimal x;
+        Decimal y;
+        {
+            const DecimalContext::Scope scope{narrow};
+            x.SetStringRepresentation("2,345");
+        }
+        {
+            const DecimalContext::Scope scope{wide};
+            y.SetStringRepresentation("-1,234567");
+            all_is_ok &= x.Rounded(2).ValueAsStringView() == "2,350000" && x.Rounded(6).ValueAsStringView() == "2,345000";
+        }
+        const DecimalContext::Scope scope{narrow};
+        DecimalContext context;
+        const auto unpacked = DecimalCodec::Unpack(DecimalCodec::Pack(std::span{&y, 1}, wide), context);
+        all_is_ok &= unpacked && (*unpacked)[0].ValueAsStringView() == "-1,234567";
+        all_is_ok &= (*unpacked)[0].Rounded(2).ValueAsStringView() == "-1,230" && (*unpacked)[0].Rounded(3).ValueAsStringView() == "-1,235";
+        assert(all_is_ok);
+    }
+    { // Деление больших операндов: частное и остаток не помещаются в 128 бит, округление - по режиму.
+        const RoundingMode modes[] = {RoundingMode::TRUNCATE, RoundingMode::HALF_EVEN, RoundingMode::HALF_UP,
+                                      RoundingMode::FLOOR, RoundingMode::CEILING};
+        const char* expected[][5] = {
+            {"0,529105831046", "0,529105831047", "0,529105831047", "0,529105831046", "0,529105831047"},
+            {"0,85779617", "0,85779617", "0,85779617", "0,85779617", "0,85779618"},
+            {"0,806914035872", "0,806914035873", "0,806914035873", "0,806914035872", "0,806914035873"},
+            {"-0,000000000242", "-0,000000000243", "-0,000000000243", "-0,000000000243", "-0,000000000242"},
+        };
+        const char* operands[][2] = {
+            {"3530261711289223209499326,000158152503", "6672127775093057927813575,810716869868"},
+            {"33069938661520832810380298922,06131481", "38552210596744028608421989963,26001063"},
+            {"-498625084567740,460559256086", "-617940774853773,286128002514"},
+            {"-6189810653425717492051898569,257043178509", "25478949240040943685246354934248600499,197353380290"},
+        };
+        const int widths[] = {12, 8, 12, 12};
+        for (int mode = 0; mode < 5; ++mode) {
+            for (int i = 0; i < 4; ++i) {
+                const DecimalContext context{widths[i], modes[mode]};
+                const DecimalContext::Scope scope{context};
+                Decimal x; x.SetStringRepresentation(operands[i][0]);
+                Decimal y; y.SetStringRepresentation(operands[i][1]);
+                all_is_ok &= (x / y).ValueAsStringView() == expected[i][mode];
+            }
+        }
+        assert(all_is_ok);
+    }
+    {
+        Decimal values[4];
+        values[0].SetStringRepresentation("-123,456");
+        values[1].SetStringRepresentation("-0,001");
+        values[2].SetInfinity();
+        values[3].SetNotANumber();
+        uint8_t buffer[DecimalCodec::MAX_DECIMAL_SIZE];
+        all_is_ok &= DecimalCodec::Encode(values[0], buffer) - buffer == 5; // Заголовок, длина, 3 байта 123456.
+        DecimalContext context;
+        const auto data = DecimalCodec::Pack(values, DecimalContext{3, RoundingMode::HALF_UP});
+        const auto unpacked = DecimalCodec::Unpack(data, context);
+        all_is_ok &= unpacked && unpacked->size() == 4 && context.Rounding() == RoundingMode::HALF_UP;
+        all_is_ok &= (*unpacked)[0].ValueAsStringView() == "-123,456" && (*unpacked)[1].ValueAsStringView() == "-0,001";
+        all_is_ok &= (*unpacked)[2].IsOverflowed() && (*unpacked)[3].IsNotANumber();
+        all_is_ok &= !DecimalCodec::Unpack(std::span{data}.first(data.size() - 1), context);
+        const std::map<U128, int> factors {{U128{2}, 3}, {U128{0, 1} + U128{51}, 1}};
+        all_is_ok &= DecimalCodec::UnpackFactors(DecimalCodec::PackFactors(factors)) == factors;
+        assert(all_is_ok);
+    }
+    { // Точное значение со всеми девятками в дробной части переживает запись и чтение в любом режиме.
+        const RoundingMode modes[] = {RoundingMode::HALF_EVEN, RoundingMode::HALF_UP, RoundingMode::FLOOR, RoundingMode::CEILING};
+        for (const RoundingMode mode : modes) {
+            const DecimalContext context{3, mode};
+            const DecimalContext::Scope scope{context};
+            Decimal values[3];
+            values[0].SetStringRepresentation("2,999");
+            values[1].SetStringRepresentation("-0,999");
+            values[2].SetStringRepresentation("-99,999");
+            DecimalContext unpacked_context;
+            const auto unpacked = DecimalCodec::Unpack(DecimalCodec::Pack(values, context), unpacked_context);
+            all_is_ok &= unpacked && unpacked->size() == 3 && unpacked_context.Rounding() == mode;
+            all_is_ok &= (*unpacked)[0].ValueAsStringView() == "2,999" && (*unpacked)[0] == values[0];
+            all_is_ok &= (*unpacked)[1].ValueAsStringView() == "-0,999" && (*unpacked)[1] == values[1];
+            all_is_ok &= (*unpacked)[2].ValueAsStringView() == "-99,999" && (*unpacked)[2] == values[2];
+        }
+        assert(all_is_ok);
+    }
+
+    {
+        Decimal root; root.SetStringRepresentation("1,414");
+        const ScaledDecimal x{root};
+        const auto& square = x * x; // 1,999396 => 1,999 => 2,000 (коррекция всех девяток).
+        char buffer[64];
+        const auto [end, ec] = to_chars(std::begin(buffer), std::end(buffer), square);
+        all_is_ok &= std::string_view(buffer, end) == "2,000";
+        all_is_ok &= (square.ToDecimal() - x.ToDecimal() * x.ToDecimal()).IsZero();
+        assert(all_is_ok);
+    }
+
+    {
+        Decimal d1; d1.SetDecimal(max_int, I128{0} );
+        all_is_ok &= ScaledDecimal{d1}.IsOverflowed(); // Модуль ScaledDecimal меньше 2^127 / 10^width.
+        all_is_ok &= (ScaledDecimal{} / ScaledDecimal{}).IsNotANumber();
+        assert(all_is_ok);
+    }
+
+    {
+        Decimal price; price.SetStringRepresentation("19,95");
+        Decimal three; three.SetDecimal(I128{3}, I128{0});
+        const auto& total = FixedDecimal<2>{price} * FixedDecimal<2>{three}; // Ширина не зависит от Decimal::SetWidth.
+        char buffer[64];
+        const auto [end, ec] = to_chars(std::begin(buffer), std::end(buffer), total);
+        all_is_ok &= std::string_view(buffer, end) == "59,85";
+        all_is_ok &= total.ToDecimal().ValueAsStringView() == "59,850";
+        assert(all_is_ok);
+    }
+
+    { // ScaledDecimal и Decimal округляют одинаково во всех режимах.
+        const RoundingMode modes[] = {RoundingMode::TRUNCATE, RoundingMode::HALF_EVEN, RoundingMode::HALF_UP,
+                                      RoundingMode::FLOOR, RoundingMode::CEILING};
+        const char* operands[][2] = {{"0,05", "0,5"}, {"1", "3"}, {"-2,99", "0,07"}, {"19,95", "-3,3"}, {"-0,01", "-0,5"}, {"2,99", "1,01"}};
+        for (const RoundingMode mode : modes) {
+            const DecimalContext context{2, mode};
+            const DecimalContext::Scope scope{context};
+            for (const auto& [a, b] : operands) {
+                Decimal x; x.SetStringRepresentation(a);
+                Decimal y; y.SetStringRepresentation(b);
+                const ScaledDecimal sx{x};
+                const ScaledDecimal sy{y};
+                all_is_ok &= sx.ToDecimal() == x && (sx + sy).ToDecimal() == x + y && (sx - sy).ToDecimal() == x - y;
+                all_is_ok &= (sx * sy).ToDecimal() == x * y && (sx / sy).ToDecimal() == x / y;
+            }
+            const std::string_view text = "-0,125";
+            ScaledDecimal parsed;
+            from_chars(text.data(), text.data() + text.size(), parsed);
+            Decimal z; z.SetStringRepresentation(std::string{text});
+            all_is_ok &= parsed.ToDecimal() == z;
+        }
+        const DecimalContext context{2, RoundingMode::HALF_UP};
+        const DecimalContext::Scope scope{context};
+        Decimal x; x.SetStringRepresentation("0,05");
+        Decimal y; y.SetStringRepresentation("0,5");
+        Decimal z; z.SetStringRepresentation("2,99");
+        all_is_ok &= (ScaledDecimal{x} * ScaledDecimal{y}).ToDecimal().ValueAsStringView() == "0,03";
+        all_is_ok &= ScaledDecimal{z}.ToDecimal().ValueAsStringView() == "2,99"; // Без коррекции девяток.
+        const DecimalContext ceiling{2, RoundingMode::CEILING};
+        const DecimalContext::Scope ceiling_scope{ceiling};
+        Decimal one; one.SetDecimal(I128{1}, I128{0});
+        Decimal three; three.SetDecimal(I128{3}, I128{0});
+        all_is_ok &= (ScaledDecimal{one} / ScaledDecimal{three}).ToDecimal().ValueAsStringView() == "0,34";
         assert(all_is_ok);
     }
 
@@ -357,6 +659,454 @@ static void run_unit_tests() {
         all_is_ok &= !normal_value.is_singular();
         assert(all_is_ok);
     }
+
+    { // "-" и "" не читаются за завершающим нулем: буфер разбора (Vector128) не обнуляется при создании
+        const DecimalContext context{3};
+        const DecimalContext::Scope scope{context};
+        Decimal x;
+        x.SetStringRepresentation("-");
+        all_is_ok &= x.ValueAsStringView() == "0,000";
+        x.SetStringRepresentation("");
+        all_is_ok &= x.IsNotANumber() && x.ValueAsStringView().empty();
+        assert(all_is_ok);
+    }
+
+    { // Ширина, заданная в одном потоке (по умолчанию или через Scope), не видна в другом
+        const int default_width = DecimalContext::ThreadDefault().Width();
+        const DecimalContext context{7};
+        const DecimalContext::Scope scope{context};
+        int other_width = -1;
+        int other_scoped_width = -1;
+        std::thread other([&] {
+            other_width = Decimal::GetWidth();
+            Decimal::SetWidth(1);
+            const DecimalContext other_context{5};
+            const DecimalContext::Scope other_scope{other_context};
+            other_scoped_width = Decimal::GetWidth();
+        });
+        other.join();
+        all_is_ok &= other_width == 3 && other_scoped_width == 5; // Новый поток стартует с контекстом DecimalContext{}.
+        all_is_ok &= Decimal::GetWidth() == 7 && DecimalContext::ThreadDefault().Width() == default_width;
+        assert(all_is_ok);
+    }
+
+    { // UBig<U128>::divrem: деление 256/128, в том числе с частным больше 2^128
+        using U256 = bignum::UBig<U128>;
+        const U128 ones = U128::max();
+        struct Case { U256 x; U128 d; U256 q; U128 r; };
+        const Case cases[] = {
+            {U256{ones, ones}, ones, U256{U128{1}, U128{1}}, U128{0}},                             // (2^256 - 1) / (2^128 - 1)
+            {U256{ones, ones}, U128{3}, U256{U128{0x5555555555555555ull, 0x5555555555555555ull},
+                                             U128{0x5555555555555555ull, 0x5555555555555555ull}}, U128{0}},
+            {U256{U128{12345}, U128{7}}, U128{10000000000000000000ull},
+             U256{U128{0xe9a812dffc2b5708ull, 0xc}}, U128{0x3244d305d8c03039ull}},                  // 64-битный делитель
+            {U256{U128{17}, U128{0, 0x100}}, U128{1, 0x8000000000000000ull},
+             U256{U128{ones.low(), 0x1ff}}, U128{0x12, 0x7ffffffffffffe00ull}},                     // 2^200 + 17, 2^127 + 1
+            {U256{U128{9}, U128{5}}, ones - U128{158}, U256{U128{5}}, U128{0x324}},                  // Старшая половина меньше делителя
+            {U256{U128{1000}}, U128{7}, U256{U128{142}}, U128{6}},                                   // Узкое делимое
+        };
+        for (const auto& c : cases) {
+            const auto [q, r] = c.x.divrem(c.d);
+            const auto [q2, r2] = c.x.divrem(bignum::u128::Divider<U128>{c.d});
+            all_is_ok &= q == c.q && r == c.r && q2 == c.q && r2 == c.r;
+        }
+        assert(all_is_ok);
+    }
+
+    { // PrimeRange: количество простых на отрезках с известным ответом
+        const auto count = [](uint64_t first, uint64_t last) {
+            u128::utils::PrimeRange range{first, last};
+            int n = 0;
+            for (auto it = range.begin(); it != range.end(); ++it)
+                ++n;
+            return n;
+        };
+        u128::utils::PrimeRange small{1, 30};
+        std::vector<uint64_t> primes;
+        for (const auto p : small)
+            primes.push_back(p);
+        all_is_ok &= primes == std::vector<uint64_t>{2, 3, 5, 7, 11, 13, 17, 19, 23, 29};
+        all_is_ok &= count(1, 1000000) == 78498;
+        all_is_ok &= count(1000000000000ull, 1000000000000ull + 1000000) == 36249;
+        all_is_ok &= count(24, 28) == 0 && count(97, 97) == 1;
+        assert(all_is_ok);
+    }
+
+    { // Метод Лемана и фильтр квадратов SquareSieve на 64-битных полупростых
+        const auto check = [](u64 p, u64 q) {
+            const auto [d1, d2] = u128::utils::lehman_method(U128::mult_ext(p, q));
+            return (d1 == p && d2 == q) || (d1 == q && d2 == p);
+        };
+        all_is_ok &= check(4294967291ull, 4294967279ull); // Близкие множители.
+        all_is_ok &= check(1000003ull, 10000000000037ull); // Множитель чуть больше корня третьей степени.
+        all_is_ok &= check(65537ull, 281470681808891ull); // Малый множитель: пробное деление.
+        const U128 prime{18446744073709551557ull};
+        all_is_ok &= u128::utils::lehman_method(prime) == std::make_pair(prime, U128{1});
+        assert(all_is_ok);
+        // Фильтр не должен отбрасывать полные квадраты последовательности Ферма y = a^2 - n.
+        const U128 n = U128::mult_ext(4294967291ull, 4294967279ull);
+        U128 a = u128::utils::isqrt(n) + U128{1};
+        U128 y = a * a - n;
+        U128 d = a + a + U128{1};
+        u128::utils::SquareSieve sieve{y, d};
+        int squares = 0;
+        int candidates = 0;
+        for (int i = 0; i < 100000; ++i) {
+            const bool maybe = sieve.maybe_square(y.low());
+            const bool square = u128::utils::is_square(y);
+            all_is_ok &= maybe || !square;
+            candidates += maybe;
+            squares += square;
+            y += d;
+            d += U128{2};
+            sieve.step();
+        }
+        all_is_ok &= squares >= 1 && candidates < 1000;
+        assert(all_is_ok);
+    }
+
+    { // isqrt, nroot, is_square на границах 2^64 и 2^128
+        using U256 = bignum::UBig<U128>;
+        const U128 two_64{0, 1};
+        const U128 ones = U128::max();
+        const U128 ones_64{ones.low()};
+        bool exact = false;
+        all_is_ok &= u128::utils::isqrt(two_64 - U128{1}, exact) == U128{0xffffffffull} && !exact;
+        all_is_ok &= u128::utils::isqrt(two_64, exact) == U128{0x100000000ull} && exact;
+        all_is_ok &= u128::utils::isqrt(two_64 + U128{1}, exact) == U128{0x100000000ull} && !exact;
+        all_is_ok &= u128::utils::isqrt(ones) == ones_64;
+        all_is_ok &= u128::utils::isqrt(ones_64 * ones_64, exact) == ones_64 && exact;
+        all_is_ok &= u128::utils::isqrt(ones_64 * ones_64 - U128{1}) == ones_64 - U128{1};
+        assert(all_is_ok);
+        U128 root;
+        all_is_ok &= u128::utils::is_square(two_64, &root) && root == U128{0x100000000ull};
+        all_is_ok &= u128::utils::is_square(ones_64 * ones_64, &root) && root == ones_64;
+        all_is_ok &= !u128::utils::is_square(two_64 + U128{1}) && !u128::utils::is_square(two_64 - U128{1});
+        all_is_ok &= !u128::utils::is_square(ones);
+        assert(all_is_ok);
+        const U128 ten_36 = u128::utils::int_power(10, 36);
+        const U128 three_80 = u128::utils::int_power(3, 80);
+        all_is_ok &= u128::utils::nroot(ten_36, 3) == U128{1000000000000ull};
+        all_is_ok &= u128::utils::nroot(ten_36 - U128{1}, 3) == U128{999999999999ull};
+        all_is_ok &= u128::utils::nroot(ones, 3) == U128{6981463658331ull};
+        all_is_ok &= u128::utils::nroot(ones, 5) == U128{50859008};
+        all_is_ok &= u128::utils::nroot(three_80, 80) == U128{3} && u128::utils::nroot(three_80 - U128{1}, 80) == U128{2};
+        all_is_ok &= u128::utils::nroot(ones, 128) == U128{1} && u128::utils::nroot(two_64, 2) == U128{0x100000000ull};
+        assert(all_is_ok);
+        // 256-битный корень: x = r^2 + остаток, 0 <= остаток <= 2r.
+        const U256 x = (U256{U128{1}} << 255) + U256{U128{12345}};
+        U256 remainder;
+        const U128 r = u128::utils::isqrt(x, &remainder);
+        all_is_ok &= r == U128{0x597d89b3754abe9full, 0xb504f333f9de6484ull};
+        all_is_ok &= U256::square_ext(r) + remainder == x && remainder <= U256{r} + U256{r};
+        all_is_ok &= u128::utils::isqrt(U256::square_ext(ones), &remainder) == ones && remainder == U256{U128{0}};
+        assert(all_is_ok);
+    }
+
+    { // Divider<U128> и div_3by2: известные частные и тождество x = q * d + r, r < d
+        using U256 = bignum::UBig<U128>;
+        const U128 ones = U128::max();
+        struct Case { U128 d; U128 q; U128 r; };
+        const Case cases[] = {
+            {U128{10000000000000000000ull}, U128{0xd83c94fb6d2ac34aull, 1}, U128{0x2ed503946aefffffull}},
+            {U128{1, 1}, U128{ones.low()}, U128{0}},                                                // 2^64 + 1
+            {U128{1, 0x8000000000000000ull}, U128{1}, U128{ones.low() - 1, 0x7fffffffffffffffull}}, // 2^127 + 1
+            {U128{3}, U128{0x5555555555555555ull, 0x5555555555555555ull}, U128{0}},
+            {U128{ones.low()}, U128{1, 1}, U128{0}},                                                // 2^64 - 1
+            {bignum::u128::pow10(38), U128{3}, U128{0xe361993fffffffffull, 0x1e4e1a06f06bb291ull}},
+            {U128{0}, U128{0}, U128{0}},                                                            // Деление на ноль
+        };
+        for (const auto& c : cases) {
+            U128 r;
+            const U128 q = bignum::u128::Divider<U128>{c.d}.divide(ones, &r);
+            all_is_ok &= q == c.q && r == c.r;
+        }
+        assert(all_is_ok);
+        // 192/128 с нормализованным делителем: (u2, u1) < d.
+        const U128 d{0xffffffffffffffffull, 0x8000000000000001ull};
+        U128 r;
+        const u64 q = bignum::u128::div_3by2(0x8000000000000000ull, 0xffffffffffffffffull, 0x123456789abcdef0ull,
+                                             d, bignum::u128::reciprocal_2words(d.high(), d.low()), r);
+        all_is_ok &= q == 0xfffffffffffffffeull && r == U128{0x123456789abcdeeeull, 4};
+        assert(all_is_ok);
+        // Делители всех разрядностей на псевдослучайных делимых.
+        u64 state = 0x9e3779b97f4a7c15ull;
+        const auto next = [&state] {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        };
+        for (int i = 0; i < 20000; ++i) {
+            const U128 x{next(), next()};
+            const U128 divisor = U128{next(), next()} >> (i % 128);
+            if (divisor == 0)
+                continue;
+            const bignum::u128::Divider<U128> divider{divisor};
+            U128 rem;
+            const U128 quot = divider.divide(x, &rem);
+            all_is_ok &= U256::mult_ext(quot, divisor) + U256{rem} == U256{x} && rem < divisor;
+            all_is_ok &= x / divider == quot && x % divider == rem;
+        }
+        assert(all_is_ok);
+    }
+
+    { // digits10, floor_log10, pow10 на границах степеней десяти
+        U128 power{1};
+        for (unsigned n = 0; n <= 38; ++n) {
+            const int digits = static_cast<int>(n) + 1;
+            all_is_ok &= bignum::u128::pow10(n) == power;
+            all_is_ok &= bignum::u128::digits10(power) == digits && bignum::u128::floor_log10(power) == digits - 1;
+            all_is_ok &= bignum::u128::digits10(power + U128{1}) == digits;
+            all_is_ok &= bignum::u128::digits10(power - U128{1}) == std::max(digits - 1, 1);
+            all_is_ok &= bignum::u128::floor_log10(power - U128{1}) == digits - 2;
+            if (n <= 19) {
+                const u64 p = power.low();
+                all_is_ok &= bignum::u128::digits10(p) == digits && bignum::u128::digits10(p - 1) == std::max(digits - 1, 1);
+            }
+            if (n < 38)
+                power = power * U128{10};
+        }
+        assert(all_is_ok);
+        all_is_ok &= bignum::u128::digits10(U128{0}) == 1 && bignum::u128::floor_log10(U128{0}) == -1;
+        all_is_ok &= bignum::u128::digits10(U128::max()) == 39 && bignum::u128::floor_log10(U128::max()) == 38;
+        all_is_ok &= bignum::u128::digits10(~0ull) == 20 && bignum::u128::digits10(0ull) == 1;
+        all_is_ok &= bignum::u128::digits10(U128{0, 1}) == 20; // 2^64
+        assert(all_is_ok);
+    }
+
+    { // U128Array: пакетные операции против поэлементных U128, длина не кратна ширине вектора
+        using U256 = bignum::UBig<U128>;
+        u64 state = 0x2545f4914f6cdd1dull;
+        const auto next = [&state] {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        };
+        constexpr size_t N = 37;
+        std::vector<U128> a(N), b(N);
+        for (size_t i = 0; i < N; ++i) {
+            a[i] = U128{next(), next()};
+            b[i] = U128{next(), next()};
+        }
+        a[0] = U128{~0ull, 0};  // Перенос из младшей половины в старшую.
+        b[0] = U128{1};
+        a[1] = U128{0, 5};      // Заем из старшей половины.
+        b[1] = U128{1};
+        a[2] = U128::max();     // Переполнение по модулю 2^128.
+        b[2] = U128{2};
+        const bignum::u128::U128Array x{std::span<const U128>{a}};
+        const bignum::u128::U128Array y{std::span<const U128>{b}};
+        const auto check = [&](const bignum::u128::U128Array& result, auto op) {
+            bool ok = result.size() == N;
+            for (size_t i = 0; ok && i < N; ++i)
+                ok = result[i] == op(a[i], b[i]);
+            return ok;
+        };
+        auto sum = x;
+        sum += y;
+        all_is_ok &= check(sum, [](U128 p, U128 q) { return p + q; }) && sum[0] == U128{0, 1} && sum[2] == U128{1};
+        auto diff = x;
+        diff -= y;
+        all_is_ok &= check(diff, [](U128 p, U128 q) { return p - q; }) && diff[1] == U128{~0ull, 4};
+        auto product = x;
+        product *= 0xfedcba9876543210ull;
+        all_is_ok &= check(product, [](U128 p, U128) { return p * U128{0xfedcba9876543210ull}; });
+        assert(all_is_ok);
+        for (const uint32_t s : {0u, 1u, 63u, 64u, 65u, 127u}) {
+            auto left = x;
+            left <<= s;
+            auto right = x;
+            right >>= s;
+            all_is_ok &= check(left, [s](U128 p, U128) { return p << s; });
+            all_is_ok &= check(right, [s](U128 p, U128) { return p >> s; });
+        }
+        auto low = x;
+        low.min_with(y);
+        auto high = x;
+        high.max_with(y);
+        all_is_ok &= check(low, [](U128 p, U128 q) { return std::min(p, q); });
+        all_is_ok &= check(high, [](U128 p, U128 q) { return std::max(p, q); });
+        std::vector<uint8_t> mask(N);
+        x.less(y, mask);
+        U256 total{0};
+        for (size_t i = 0; i < N; ++i) {
+            all_is_ok &= mask[i] == (a[i] < b[i] ? 1 : 0);
+            total += U256{a[i]};
+        }
+        all_is_ok &= x.sum() == total;
+        std::vector<U128> back(N);
+        x.copy_to(back);
+        all_is_ok &= back == a;
+        assert(all_is_ok);
+    }
+
+    { // S128: переполнение сложения, вычитания и умножения на границах симметричного диапазона
+        using bignum::s128::S128;
+        const U128 max_magnitude = (U128::max() >> 1) - U128{1}; // 2^127 - 2
+        const S128 max{max_magnitude};
+        const S128 min{max_magnitude, true};
+        all_is_ok &= !max.is_singular() && !min.is_singular() && -max == min && min.abs() == max;
+        all_is_ok &= S128{max_magnitude + U128{1}}.is_overflow() && S128{max_magnitude + U128{1}, true}.is_overflow();
+        all_is_ok &= (max + S128{1}).is_overflow() && (max - S128{1}) + S128{1} == max;
+        all_is_ok &= (min - S128{1}).is_overflow() && (min + S128{1}) - S128{1} == min;
+        all_is_ok &= (max - min).is_overflow() && (min - max).is_overflow() && (max + min).is_zero();
+        all_is_ok &= (max - max).is_zero() && (min - min).is_zero();
+        assert(all_is_ok);
+        const S128 two_63{U128{1ull << 63}};
+        const S128 two_64{U128{0, 1}};
+        all_is_ok &= (two_64 * two_64).is_overflow() && (two_64 * -two_64).is_overflow();
+        all_is_ok &= (two_64 * two_63).is_overflow() && (-two_64 * two_63).is_overflow(); // 2^127
+        all_is_ok &= (max * S128{2}).is_overflow() && (min * S128{2}).is_overflow() && max * S128{1} == max;
+        all_is_ok &= max * -S128{1} == min && min * -S128{1} == max;
+        all_is_ok &= (S128{U128{0, 0x3fffffffffffffffull}} * S128{2})== S128{U128{0, 0x7ffffffffffffffeull}};
+        assert(all_is_ok);
+    }
+
+    { // S128: "нечисло" заразно и старше переполнения, сингулярности несравнимы
+        using bignum::s128::S128;
+        const S128 nan = S128::nan();
+        const S128 inf = S128::overflow();
+        const S128 one{1};
+        all_is_ok &= nan.is_nan() && !nan.is_overflow() && inf.is_overflow() && !inf.is_nan();
+        all_is_ok &= nan.is_singular() && inf.is_singular() && !nan.is_negative() && !inf.is_negative();
+        all_is_ok &= (nan + one).is_nan() && (one - nan).is_nan() && (nan * one).is_nan();
+        all_is_ok &= (inf + one).is_overflow() && (one - inf).is_overflow() && (inf * one).is_overflow();
+        all_is_ok &= (nan + inf).is_nan() && (inf * nan).is_nan() && (-nan).is_nan() && (-inf).is_overflow();
+        all_is_ok &= !(nan == nan) && !(inf == inf) && !(inf < one) && !(inf > one) && !(nan >= one);
+        all_is_ok &= (inf / one).first.is_overflow() && (nan / one).first.is_nan();
+        all_is_ok &= nan.toString() == "nan" && inf.toString() == "inf";
+        I128 overflowed;
+        overflowed.set_overflow();
+        all_is_ok &= S128{overflowed}.is_overflow() && S128{I128{}}.is_zero() && S128{-I128{7}} == -S128{7};
+        assert(all_is_ok);
+    }
+
+    { // Строка после арифметики и чтение одного числа из нескольких потоков
+        const DecimalContext context{3};
+        const DecimalContext::Scope scope{context};
+        Decimal x; x.SetStringRepresentation("1,5");
+        Decimal y; y.SetStringRepresentation("-2,25");
+        all_is_ok &= x.ValueAsStringView() == "1,500";
+        x = x + y;
+        all_is_ok &= x.ValueAsStringView() == "-0,750";
+        x = x * y;
+        all_is_ok &= x.ValueAsStringView() == "1,687";
+        const Decimal copy = x;
+        x.SetDecimal(I128{7}, I128{0});
+        all_is_ok &= x.ValueAsStringView() == "7,000" && copy.ValueAsStringView() == "1,687";
+        const auto text = (x / y).ValueAsStringView(); // Буфер принадлежит результату, а не временному числу.
+        all_is_ok &= text == "-3,111";
+        assert(all_is_ok);
+        const Decimal shared = x / y;
+        bool same[4] = {};
+        std::vector<std::thread> readers;
+        for (bool& result : same)
+            readers.emplace_back([&shared, &result] {
+                bool ok = true;
+                for (int i = 0; i < 1000; ++i)
+                    ok &= shared.ValueAsStringView() == "-3,111";
+                result = ok;
+            });
+        for (auto& reader : readers)
+            reader.join();
+        all_is_ok &= same[0] && same[1] && same[2] && same[3];
+        assert(all_is_ok);
+    }
+}
+#endif
+
+#ifdef RUN_BENCHMARKS
+/**
+ * @brief Среднее время одной операции, нс: f(i) вызывается для i = 0..count-1 несколько раз подряд.
+ */
+template <typename F>
+static double nanoseconds_per_op(size_t count, F f) {
+    constexpr int repeats = 20;
+    volatile bool sink = false;
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r)
+        for (size_t i = 0; i < count; ++i)
+            sink = f(i);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    (void)sink;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (repeats * count);
+}
+
+static void run_benchmarks() {
+    using bignum::i128::I128;
+    using bignum::s128::S128;
+    std::mt19937_64 generator{1};
+    constexpr size_t count = 4096;
+
+    { // Целые: знако-модульное I128 против S128 в дополнительном коде, модули до 2^62
+        std::vector<I128> xi(count), yi(count);
+        std::vector<S128> xs(count), ys(count);
+        for (size_t i = 0; i < count; ++i) {
+            const bool negative = generator() & 1;
+            const U128 x{generator() >> 2};
+            const U128 y{generator() >> 2};
+            xi[i] = negative ? -I128{x} : I128{x};
+            yi[i] = I128{y};
+            xs[i] = S128{x, negative};
+            ys[i] = S128{y};
+        }
+        qDebug().noquote() << QString::asprintf("I128: + %.1f, - %.1f, * %.1f ns/op",
+            nanoseconds_per_op(count, [&](size_t i) { return (xi[i] + yi[i]).is_zero(); }),
+            nanoseconds_per_op(count, [&](size_t i) { return (xi[i] - yi[i]).is_zero(); }),
+            nanoseconds_per_op(count, [&](size_t i) { return (xi[i] * yi[i]).is_zero(); }));
+        qDebug().noquote() << QString::asprintf("S128: + %.1f, - %.1f, * %.1f ns/op",
+            nanoseconds_per_op(count, [&](size_t i) { return (xs[i] + ys[i]).is_zero(); }),
+            nanoseconds_per_op(count, [&](size_t i) { return (xs[i] - ys[i]).is_zero(); }),
+            nanoseconds_per_op(count, [&](size_t i) { return (xs[i] * ys[i]).is_zero(); }));
+    }
+
+    { // Decimal на текущем целом (I128 или S128 при DECIMAL_S128)
+#if defined(DECIMAL_S128)
+        const char* backend = "S128";
+#else
+        const char* backend = "I128";
+#endif
+        const DecimalContext context{6};
+        const DecimalContext::Scope scope{context};
+        std::vector<Decimal> x(count), y(count);
+        for (size_t i = 0; i < count; ++i) {
+            x[i].SetDecimal(I128{generator() % 1000000}, I128{generator() % 1000000});
+            y[i].SetDecimal(I128{generator() % 1000 + 1}, I128{generator() % 1000000});
+        }
+        qDebug().noquote() << QString::asprintf("Decimal (%s): + %.1f, - %.1f, * %.1f, / %.1f ns/op", backend,
+            nanoseconds_per_op(count, [&](size_t i) { return (x[i] + y[i]).IsZero(); }),
+            nanoseconds_per_op(count, [&](size_t i) { return (x[i] - y[i]).IsZero(); }),
+            nanoseconds_per_op(count, [&](size_t i) { return (x[i] * y[i]).IsZero(); }),
+            nanoseconds_per_op(count, [&](size_t i) { return (x[i] / y[i]).IsZero(); }));
+    }
+
+    { // Элементарные функции: время на операцию в зависимости от ширины дробной части
+        constexpr size_t math_count = 512;
+        qDebug().noquote() << "Width: Exp, Ln, Pow, Sin, Cos, Atan, Sqrt ns/op";
+        for (int width : {0, 3, 6, 9, 12}) {
+            const DecimalContext context{width, RoundingMode::HALF_EVEN};
+            const DecimalContext::Scope scope{context};
+            uint64_t denominator = 1;
+            for (int i = 0; i < width; ++i)
+                denominator *= 10;
+            std::vector<Decimal> x(math_count), y(math_count);
+            for (size_t i = 0; i < math_count; ++i) {
+                x[i].SetDecimal(I128{generator() % 50}, I128{generator() % denominator});
+                y[i].SetDecimal(I128{generator() % 5}, I128{generator() % denominator});
+            }
+            bool exact;
+            qDebug().noquote() << QString::asprintf("%2d: %.0f, %.0f, %.0f, %.0f, %.0f, %.0f, %.0f", width,
+                nanoseconds_per_op(math_count, [&](size_t i) { return Exp(x[i]).IsZero(); }),
+                nanoseconds_per_op(math_count, [&](size_t i) { return Ln(x[i]).IsZero(); }),
+                nanoseconds_per_op(math_count, [&](size_t i) { return Pow(x[i], y[i]).IsZero(); }),
+                nanoseconds_per_op(math_count, [&](size_t i) { return Sin(x[i]).IsZero(); }),
+                nanoseconds_per_op(math_count, [&](size_t i) { return Cos(x[i]).IsZero(); }),
+                nanoseconds_per_op(math_count, [&](size_t i) { return Atan(x[i]).IsZero(); }),
+                nanoseconds_per_op(math_count, [&](size_t i) { return Sqrt(x[i], exact).IsZero(); }));
+        }
+    }
 }
 #endif
 
@@ -374,6 +1124,7 @@ int main(int argc, char *argv[])
     QGuiApplication app(argc, argv);
 
     qRegisterMetaType<QVector<dec_n::Decimal>>("QVector<dec_n::Decimal>");
+    qRegisterMetaType<dec_n::DecimalContext>("dec_n::DecimalContext");
 
     qmlRegisterUncreatableMetaObject(OperationEnums::staticMetaObject,
                                      "operation.enums",
@@ -398,6 +1149,12 @@ int main(int argc, char *argv[])
     });
 #endif
 
+#ifdef RUN_BENCHMARKS
+    QTimer::singleShot(0, &AppCore, [](){
+        run_benchmarks();
+    });
+#endif
+
     auto ctx = engine.rootContext();
     ctx->setContextProperty("AppCore", &AppCore);
 
@@ -53,7 +53,7 @@ public:
                 continue;
             }
             mIdx = (mIdx + 1) % tp::BUFFER_SIZE;
-            emit mController->operate(mRequest[mIdx].mOperation, mRequest[mIdx].mOperands);
+            emit mController->operate(mRequest[mIdx].mOperation, mRequest[mIdx].mOperands, mRequest[mIdx].mContext);
             mFree->release();
         }
     }
@@ -24,6 +24,10 @@ struct Request {
      * Обернуты в Qt вектор из-за обеспечения безопасной передачи из потока в поток.
      */
     QVector<dec_n::Decimal> mOperands;
+    /**
+     * @brief Контекст вычислений (количество знаков после запятой) на момент запроса.
+     */
+    dec_n::DecimalContext mContext;
 };
 
 /**
@@ -26,8 +26,10 @@ public slots:
      * Уведомляет контроллер о готовности результата.
      * @param operation Код операции.
      * @param operands Операнды.
+     * @param context Контекст вычислений, с которым сформирован запрос.
      */
-    void do_work(int operation, QVector<dec_n::Decimal> operands) {
+    void do_work(int operation, QVector<dec_n::Decimal> operands, dec_n::DecimalContext context) {
+        const dec_n::DecimalContext::Scope scope{context};
         int error_code;
         bool exact_sqrt = false;
         if (operation == calculus::FACTOR) {
@@ -51,18 +53,10 @@ public slots:
         else {
             mValue.resize(1);
             // Операнды копируются.
-            mValue[0] = doIt(operation, operands[0], operands[1], error_code, exact_sqrt);
+            mValue[0] = doIt(context, operation, operands[0], operands[1], error_code, exact_sqrt);
         }
         emit results_ready(error_code, operation, exact_sqrt, mValue);
     }
-
-    /**
-     * @brief Синхронизировать количество знаков после запятой в Decimal в пространстве библиотеки.
-     * @param width Количество знаков после запятой.
-     */
-    void sync_decimal_width(int width) {
-        changeDecimalWidth(width);
-    }
 signals:
     /**
      * @brief Уведомляет контроллер о готовности результата.
@@ -1,5 +1,8 @@
 #include "calculus.h"
 
+#include <thread>
+#include <vector>
+
 
 namespace calculus {
 
@@ -16,7 +19,7 @@ bignum::u128::U128 get_random(bool half, int &error)
 
 }
 
-dec_n::Decimal doIt(int operation, dec_n::Decimal x, dec_n::Decimal y, int& error_code, bool& exact_sqrt)
+dec_n::Decimal calculus::apply(int operation, const dec_n::Decimal& x, const dec_n::Decimal& y, int& error_code, bool& exact_sqrt)
 {
     error_code = calculus::NO_ERRORS;
     dec_n::Decimal result {};
@@ -50,7 +53,7 @@ dec_n::Decimal doIt(int operation, dec_n::Decimal x, dec_n::Decimal y, int& erro
             return result;
         }
         break;
-    case calculus::NEG: result = dec_n::Decimal{} - x;
+    case calculus::NEG: result = -x;
         return result;
     case calculus::SQRT: result = dec_n::Sqrt(x, exact_sqrt);
         return result;
@@ -102,9 +105,48 @@ dec_n::Decimal doIt(int operation, dec_n::Decimal x, dec_n::Decimal y, int& erro
     return dec_n::Decimal{};
 }
 
-void changeDecimalWidth(int width)
+dec_n::Decimal doIt(const dec_n::DecimalContext& context, int operation, dec_n::Decimal x, dec_n::Decimal y, int& error_code, bool& exact_sqrt)
+{
+    const dec_n::DecimalContext::Scope scope{context};
+    return calculus::apply(operation, x, y, error_code, exact_sqrt);
+}
+
+void doItBatch(const dec_n::DecimalContext& context, int operation,
+               std::span<const dec_n::Decimal> x, std::span<const dec_n::Decimal> y,
+               std::span<dec_n::Decimal> out, std::span<int> errors)
+{
+    const bool is_unary = operation > calculus::SEPARATOR;
+    assert(is_unary || y.size() == x.size());
+    assert(out.size() == x.size() && errors.size() == x.size());
+    const dec_n::DecimalContext::Scope scope{context};
+    const dec_n::Decimal zero {};
+    bool exact_sqrt;
+    for (size_t i = 0; i < x.size(); ++i)
+        out[i] = calculus::apply(operation, x[i], is_unary ? zero : y[i], errors[i], exact_sqrt);
+}
+
+void doItBatchParallel(const dec_n::DecimalContext& context, int operation,
+                       std::span<const dec_n::Decimal> x, std::span<const dec_n::Decimal> y,
+                       std::span<dec_n::Decimal> out, std::span<int> errors, int threads)
 {
-    dec_n::Decimal::SetWidth(width);
+    constexpr size_t min_chunk = 4096; // Меньшие части не окупают запуск потока.
+    if (threads <= 0)
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const size_t chunks = std::clamp<size_t>(x.size() / min_chunk, 1, threads);
+    const bool is_unary = operation > calculus::SEPARATOR;
+    const auto run = [&](size_t chunk) {
+        const size_t first = x.size() * chunk / chunks;
+        const size_t count = x.size() * (chunk + 1) / chunks - first;
+        doItBatch(context, operation, x.subspan(first, count), is_unary ? y : y.subspan(first, count),
+                  out.subspan(first, count), errors.subspan(first, count));
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(chunks - 1);
+    for (size_t chunk = 1; chunk < chunks; ++chunk)
+        workers.emplace_back(run, chunk);
+    run(0); // Первая часть - в вызывающем потоке.
+    for (auto& worker : workers)
+        worker.join();
 }
 
 void stopCaclulation() {
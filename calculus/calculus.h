@@ -48,10 +48,18 @@ CALCULUS_EXPORT std::map<bignum::u128::U128, int> factor(bignum::u128::U128 x, i
  */
 CALCULUS_EXPORT bignum::u128::U128 get_random(bool half, int& error);
 
+/**
+ * @brief Выполнить арифметическую операцию в текущем контексте потока, не устанавливая его;
+ * в остальном то же, что doIt. Операнды передаются по ссылке.
+ */
+CALCULUS_EXPORT dec_n::Decimal apply(int operation, const dec_n::Decimal& x, const dec_n::Decimal& y, int& error, bool& exact_sqrt);
+
 }
 
 /**
  * @brief Выполнить арифметическую операцию.
+ * @param context Контекст вычислений (количество знаков после запятой): на время вызова
+ * становится текущим для потока, поэтому вызовы с разной точностью могут идти параллельно.
  * @param operation Операция.
  * @param x Операнд 1.
  * @param y Операнд 2.
@@ -59,14 +67,27 @@ CALCULUS_EXPORT bignum::u128::U128 get_random(bool half, int& error);
  * @param exact_sqrt Точно ли извлекся квадратный корень.
  * @return Реузльтат операции.
  */
-CALCULUS_EXPORT dec_n::Decimal doIt(int operation, dec_n::Decimal x, dec_n::Decimal y, int& error, bool& exact_sqrt);
+CALCULUS_EXPORT dec_n::Decimal doIt(const dec_n::DecimalContext& context, int operation, dec_n::Decimal x, dec_n::Decimal y, int& error, bool& exact_sqrt);
+
+/**
+ * @brief Выполнить операцию над столбцами операндов: out[i] = x[i] (operation) y[i], errors[i] - код ошибки.
+ * Операнды не копируются, контекст устанавливается один раз на весь пакет; сами операнды
+ * должны быть получены при той же ширине, что и context.
+ * @param y Второй операнд; для однооперандных операций (после SEPARATOR) не используется и может быть пустым.
+ * @param out, errors Результаты и коды ошибок; размеры x, out, errors (и y для двухоперандных операций) совпадают.
+ */
+CALCULUS_EXPORT void doItBatch(const dec_n::DecimalContext& context, int operation,
+                               std::span<const dec_n::Decimal> x, std::span<const dec_n::Decimal> y,
+                               std::span<dec_n::Decimal> out, std::span<int> errors);
 
 /**
- * @brief Изменить количество знаков после запятой у Decimal. Несмотря на статическую переменную,
- * это требуется, потому что это код библиотеки (dll, so), который отличается от кода основного приложения.
- * @param width Количество знаков после запятой.
+ * @brief То же, что doItBatch, но пакет делится на непрерывные части, которые считаются в отдельных потоках
+ * (первая - в вызывающем). Небольшие пакеты считаются в одном потоке.
+ * @param threads Наибольшее число потоков; 0 - по числу ядер процессора.
  */
-CALCULUS_EXPORT void changeDecimalWidth(int width);
+CALCULUS_EXPORT void doItBatchParallel(const dec_n::DecimalContext& context, int operation,
+                                       std::span<const dec_n::Decimal> x, std::span<const dec_n::Decimal> y,
+                                       std::span<dec_n::Decimal> out, std::span<int> errors, int threads = 0);
 
 /**
  * @brief Остановить текущее вычисление разово.
@@ -10,6 +10,7 @@ TARGET = calculus
 win32:CONFIG(debug, debug|release): TARGET = calculusd  # Добавит 'd' в конце для Debug
 
 CONFIG += c++20
+CONFIG += thread  # doItBatchParallel
 
 include(..\config.pri)
 
@@ -18,20 +19,32 @@ QMAKE_CXXFLAGS += -fwrapv
 SOURCES += \
     calculus.cpp \
     ecm_factorizer.cpp \
+    expression.cpp \
+    mul_kernels.cpp \
+    prime_range.cpp \
+    u128_array.cpp \
     u128_utils.cpp
 
 HEADERS += \
     calculus_global.h \
     calculus.h \
     decimal.h \
+    decimal_math.h \
+    decimal_wire.h \
     ecm_factorizer.h \
+    expression.h \
     lfsr.h \
+    mul_kernels.h \
+    prime_range.h \
     rand_u128.h \
     random_gen.h \
     sign.h \
     singular.h \
     i128.hpp \
+    s128.hpp \
+    scaled_decimal.h \
     u128.hpp \
+    u128_array.h \
     ubig.hpp \
     ulow.hpp \
     defines.h \
@@ -3,9 +3,17 @@
 #include <cassert>   // assert
 #include <array>     // std::array
 #include <string>    // std::string
+#include <string_view> // std::string_view
+#include <charconv>  // std::to_chars_result, std::from_chars_result
 #include <climits>   // CHAR_BIT
+#include <cstdint>   // uint8_t, uint16_t
 #include <algorithm> // std::clamp
+#include <compare>   // std::weak_ordering
+#include <functional> // std::hash
+#include <span>      // std::span
+#include <type_traits> // std::is_trivially_copyable_v
 #include "i128.hpp"    // I128
+#include "s128.hpp"    // S128
 #include "u128_utils.h"
 #include "defines.h"
 
@@ -13,6 +21,16 @@ namespace dec_n {
 
 using namespace bignum::i128;
 
+/**
+ * @brief Целое, на котором построен Decimal: знако-модульное I128 (по умолчанию)
+ * или компактное S128 в дополнительном коде (DEFINES += DECIMAL_S128) с модулем до 2^127.
+ */
+#if defined(DECIMAL_S128)
+using Integer = bignum::s128::S128;
+#else
+using Integer = bignum::i128::I128;
+#endif
+
 constexpr int undigits(char d) {
     if (d >= '0' && d <= '9') return d - '0';
     return 0;
@@ -29,6 +47,9 @@ namespace chars {
 /**
  * @brief Класс для хранения строкового представления Decimal числа,
  * основанного на 128-битных целой и дробной частей.
+ * Буфер встроенный, фиксированного размера, с длиной и завершающим нулем; значим только префикс
+ * длины mRealSize. Копирование и перемещение тривиальные (один memcpy без заполнения нулями).
+ * Возвращается по значению из Decimal::ValueAsStringView и читается как std::string_view.
  */
 class Vector128 {
     /**
@@ -37,14 +58,14 @@ class Vector128 {
     static constexpr int MAX_SIZE = 80;
 
     /**
-     * @brief Буфер символов строкового представления числа.
+     * @brief Буфер символов строкового представления числа. Не обнуляется при создании.
      */
-    std::array<char, MAX_SIZE + 1> mBuffer{};
+    std::array<char, MAX_SIZE + 1> mBuffer;
 
     /**
-     * @brief Значимый размер буфера.
+     * @brief Значимый размер буфера; MAX_SIZE помещается в байт.
      */
-    int mRealSize = 0;
+    uint8_t mRealSize = 0;
 
     /**
      * @brief Приводит размер к отрезку [0, MAX_SIZE].
@@ -61,48 +82,39 @@ class Vector128 {
      * @param size Длина строкового представления числа.
      */
     void FillData(const char* input, int size) {
-        mRealSize = BoundSize(size);
-        // Копируем данные
+        mRealSize = static_cast<uint8_t>(BoundSize(size));
+        // Копируем данные и защитный ноль в конце
         std::copy_n(input, mRealSize, mBuffer.begin());
-        // Обнуляем оставшуюся часть (включая защитный ноль в конце)
-        std::fill(mBuffer.begin() + mRealSize, mBuffer.end(), chars::null);
+        mBuffer[mRealSize] = chars::null;
     }
 public:
     /**
-     * @brief Конструктор по умолчанию.
+     * @brief Конструктор по умолчанию: пустая строка.
      */
-    explicit Vector128() = default;
+    explicit Vector128() noexcept {
+        mBuffer[0] = chars::null;
+    }
 
     /**
      * @brief Конструктор.
      * @param str
      */
-    Vector128(const std::string& str) noexcept {
+    Vector128(std::string_view str) noexcept {
         FillData(str.data(), str.size());
     }
 
     Vector128(std::string&& str) = delete;
 
-    /**
-     * @brief Конструктор копирования.
-     * @param other
-     */
-    Vector128(const Vector128& other) noexcept {
-        FillData(other.mBuffer.data(), other.RealSize());
-    }
-
-    Vector128(Vector128&& other) = delete;
+    Vector128(const Vector128& other) = default;
+    Vector128(Vector128&& other) = default;
+    Vector128& operator=(const Vector128& other) = default;
+    Vector128& operator=(Vector128&& other) = default;
 
-    Vector128& operator=(const std::string& str) {
+    Vector128& operator=(std::string_view str) {
         FillData(str.data(), str.size());
         return *this;
     }
 
-    Vector128& operator=(const Vector128& other) {
-        FillData(other.mBuffer.data(), other.RealSize());
-        return *this;
-    }
-
     char& operator[](int i) noexcept {
         assert(i >= 0);
         assert(i < MAX_SIZE);
@@ -119,91 +131,311 @@ public:
         return mRealSize;
     }
 
-    static int MaxSize() {
+    static constexpr int MaxSize() {
         return MAX_SIZE;
     }
 
     void Resize(int new_size) {
-        mRealSize = BoundSize(new_size);
+        mRealSize = static_cast<uint8_t>(BoundSize(new_size));
         mBuffer[mRealSize] = chars::null;
     }
 
+    /**
+     * @brief Буфер для прямой записи символов; размер затем задается через Resize.
+     */
+    char* Data() noexcept {
+        return mBuffer.data();
+    }
+
+    const char* Data() const noexcept {
+        return mBuffer.data();
+    }
+
     /**
      * @brief Получить строковое представления числа.
      */
     auto GetStringView() const noexcept {
         return std::string_view(mBuffer.data(), mRealSize);
     }
+
+    /**
+     * @brief Доступ в стиле std::string_view.
+     */
+    operator std::string_view() const noexcept {
+        return GetStringView();
+    }
+
+    const char* data() const noexcept {
+        return mBuffer.data();
+    }
+
+    size_t size() const noexcept {
+        return mRealSize;
+    }
+
+    bool empty() const noexcept {
+        return mRealSize == 0;
+    }
+
+    bool starts_with(std::string_view prefix) const noexcept {
+        return GetStringView().starts_with(prefix);
+    }
+
+    bool operator==(std::string_view other) const noexcept {
+        return GetStringView() == other;
+    }
 };
 
-class Decimal {
+/**
+ * @brief Режим округления отбрасываемых знаков.
+ */
+enum class RoundingMode : uint8_t {
+    TRUNCATE,  // Отбрасывание (к нулю) с коррекцией всех девяток: поведение по умолчанию.
+    HALF_EVEN, // К ближайшему, половина - к четному (банковское округление).
+    HALF_UP,   // К ближайшему, половина - от нуля.
+    FLOOR,     // К минус бесконечности.
+    CEILING,   // К плюс бесконечности.
+};
+
+namespace rounding {
+
+/**
+ * @brief Класс отбрасываемого остатка r относительно делителя d: доля r/d.
+ */
+enum Remainder : unsigned {
+    EXACT,      // r = 0
+    BELOW_HALF, // 0 < r/d < 1/2
+    HALF,       // r/d = 1/2
+    ABOVE_HALF, // r/d > 1/2
+};
 
-    static struct _Static {
-        /**
-         * @brief Количество цифр после запятой. Не более 19 для 128-битных чисел.
-         */
-        int mWidth = 3;
+/**
+ * @brief Класс остатка r < d (U128 или UBig<U128>); сравнение с d - r не переполняется.
+ */
+template <typename T>
+constexpr Remainder Classify(const T& remainder, const T& divisor) {
+    if (remainder == T{0})
+        return EXACT;
+    const T rest = divisor - remainder;
+    return remainder < rest ? BELOW_HALF : remainder == rest ? HALF : ABOVE_HALF;
+}
+
+/**
+ * @brief Таблица решений: бит номер 4 * remainder + 2 * negative + odd в слове режима равен единице,
+ * если модуль частного увеличивается на единицу (odd - нечетность модуля частного).
+ */
+inline constexpr auto INCREMENT = [] {
+    std::array<uint16_t, 5> table{};
+    for (unsigned index = 0; index < 16; ++index) {
+        const auto remainder = static_cast<Remainder>(index >> 2);
+        const bool negative = (index & 2) != 0;
+        const bool odd = (index & 1) != 0;
+        const bool is_inexact = remainder != EXACT;
+        const bool increment[] = {
+            false,                                                   // TRUNCATE
+            remainder == ABOVE_HALF || (remainder == HALF && odd),   // HALF_EVEN
+            remainder >= HALF,                                       // HALF_UP
+            is_inexact && negative,                                  // FLOOR
+            is_inexact && !negative,                                 // CEILING
+        };
+        for (size_t mode = 0; mode < table.size(); ++mode)
+            table[mode] |= static_cast<uint16_t>(increment[mode]) << index;
+    }
+    return table;
+}();
+
+/**
+ * @brief Шаг округления: увеличить ли на единицу модуль частного, отбросив остаток данного класса.
+ */
+constexpr bool Increment(RoundingMode mode, Remainder remainder, bool negative, bool odd) {
+    const unsigned index = 4 * remainder + 2 * negative + odd;
+    return (INCREMENT[static_cast<size_t>(mode)] >> index) & 1;
+}
+
+}
+
+/**
+ * @brief Контекст вычислений Decimal: количество знаков после запятой, знаменатель 10^width и режим округления.
+ * Контекст передается в операции явно (см. doIt) или устанавливается текущим для потока через Scope.
+ * У каждого потока свой контекст по умолчанию (его меняет Decimal::SetWidth), поэтому потоки
+ * с разной точностью считают одновременно, не мешая друг другу и без синхронизации.
+ */
+class DecimalContext {
+public:
+    /**
+     * @brief Наибольшее количество цифр после запятой.
+     */
+    static constexpr int MAX_WIDTH = 12;
+
+    /**
+     * @brief Конструктор по умолчанию: три знака после запятой.
+     */
+    constexpr DecimalContext() noexcept : DecimalContext(3) {}
 
-        /**
-         * @brief Наибольшее количество цифр после запятой.
-         */
-        static constexpr int MAX_WIDTH = 12;
+    /**
+     * @brief Конструктор.
+     * @param width Количество знаков после запятой, приводится к отрезку [0, MAX_WIDTH].
+     */
+    constexpr explicit DecimalContext(int width, RoundingMode rounding = RoundingMode::TRUNCATE) noexcept
+        : mRounding{rounding} {
+        SetWidth(width);
+    }
 
-        /**
-         * @brief Знаменатель дробной части числа.
-         */
-        I128 mDenominator = u128::utils::int_power(10, mWidth);
-    } global;
+    /**
+     * @brief Установить количество знаков после запятой.
+     * @return Произошло ли изменение количества знаков.
+     */
+    constexpr bool SetWidth(int width) noexcept {
+        const int old_width = mWidth;
+        mWidth = std::clamp(width, 0, MAX_WIDTH);
+        mDenominator = Integer{bignum::u128::pow10(mWidth)};
+        return mWidth != old_width;
+    }
+
+    constexpr int Width() const noexcept {
+        return mWidth;
+    }
+
+    /**
+     * @brief Знаменатель дробной части, 10^width.
+     */
+    constexpr const Integer& Denominator() const noexcept {
+        return mDenominator;
+    }
+
+    /**
+     * @brief Установить режим округления результатов операций.
+     */
+    constexpr void SetRounding(RoundingMode rounding) noexcept {
+        mRounding = rounding;
+    }
+
+    constexpr RoundingMode Rounding() const noexcept {
+        return mRounding;
+    }
+
+    /**
+     * @brief Текущий контекст потока: установленный через Scope или контекст потока по умолчанию.
+     */
+    static const DecimalContext& Current() noexcept {
+        return tCurrent != nullptr ? *tCurrent : tDefault;
+    }
+
+    /**
+     * @brief Контекст потока по умолчанию.
+     */
+    static DecimalContext& ThreadDefault() noexcept {
+        return tDefault;
+    }
+
+    /**
+     * @brief Делает контекст текущим для потока на время своей жизни; вложенные Scope допускаются.
+     */
+    class Scope {
+    public:
+        explicit Scope(const DecimalContext& context) noexcept : mPrevious{tCurrent} {
+            tCurrent = &context;
+        }
+
+        ~Scope() {
+            tCurrent = mPrevious;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const DecimalContext* mPrevious;
+    };
+
+private:
+    /**
+     * @brief Количество цифр после запятой, от 0 до MAX_WIDTH.
+     */
+    int mWidth = -1;
+
+    /**
+     * @brief Знаменатель дробной части числа.
+     */
+    Integer mDenominator {1};
+
+    RoundingMode mRounding = RoundingMode::TRUNCATE;
+
+    static thread_local DecimalContext tDefault;
+    static thread_local const DecimalContext* tCurrent;
+};
+
+inline thread_local constinit DecimalContext DecimalContext::tDefault{};
+inline thread_local constinit const DecimalContext* DecimalContext::tCurrent = nullptr;
+
+class Decimal {
+
+    using U256 = bignum::UBig<U128>;
 
     /**
      * @brief Целая часть числа.
      */
-    I128 mInteger {0};
+    Integer mInteger {0};
 
     /**
      * @brief Числитель дробной части числа.
      */
-    I128 mNominator {0};
+    Integer mNominator {0};
 
     /**
      * @brief Измененный знаменатель. В процессе операций иногда требуется изменить знаменатель.
      * Если значение -1, то знаменатель не изменился.
      * Значение по умолчанию равно нулю для отработки NaN.
      */
-    I128 mChangedDenominator {0};
+    Integer mChangedDenominator {0};
 
     /**
-     * @brief Строковое представление числа.
+     * @brief Признак отрицательного числа, округлившегося до нуля: выводится как "-0,000".
      */
-    Vector128 mStringRepresentation;
+    bool mNegativeZero = false;
 
     /**
-     * @brief Преобразовать компоненты Decimal в строковое представление числа.
+     * @brief Переполнение: знак хранится и в целой части, и в числителе.
      */
-    void TransformToString() {
+    void SetInfinityState() {
+        mInteger = -Integer{1};
+        mNominator = -Integer{1};
+    }
+
+    /**
+     * @brief Привести компоненты Decimal к каноническому виду: знаменатель 10^width, числитель по модулю
+     * меньше знаменателя, знак - в целой части (или в числителе, если целая часть равна нулю).
+     */
+    void Normalize() {
+        mNegativeZero = false;
         if (IsOverflowed()) {
-            mStringRepresentation = "inf";
+            SetInfinityState();
             return;
         }
         if (IsNotANumber()) {
-            mStringRepresentation = "";
+            mInteger = Integer{0};
+            mNominator = Integer{0};
+            mChangedDenominator = Integer{0};
             return;
         }
-        mChangedDenominator = mChangedDenominator == -I128{1} ? global.mDenominator : mChangedDenominator;
-        // Сократим общий множитель.
-        auto gcd = u128::utils::gcd(mNominator.unsigned_part(), mChangedDenominator.unsigned_part());
-        if (!mNominator.is_zero() && gcd > I128{1}) {
-            mNominator = (mNominator / gcd).first;
-            mChangedDenominator = (mChangedDenominator / gcd).first;
+        mChangedDenominator = mChangedDenominator == -Integer{1} ? Denominator() : mChangedDenominator;
+        // Сократим общий множитель. При эталонном знаменателе сокращение и обратное
+        // масштабирование ниже взаимно уничтожаются, поэтому пропускаются.
+        if (!mNominator.is_zero() && mChangedDenominator != Denominator()) {
+            const auto gcd = u128::utils::gcd(mNominator.unsigned_part(), mChangedDenominator.unsigned_part());
+            if (gcd > Integer{1}) {
+                mNominator = (mNominator / gcd).first;
+                mChangedDenominator = (mChangedDenominator / gcd).first;
+            }
         }
         auto r = mInteger;
         const int the_sign = IsNegative();
         // Выделим целую часть при необходимости.
         if (mNominator.abs() >= mChangedDenominator) {
-            const auto& [tmp, remainder] = mNominator / mChangedDenominator;
+            const auto& [tmp, remainder] = mNominator.abs() / mChangedDenominator; // Модуль: у слабо отрицательного числа знак в числителе.
             r = the_sign == 0 ? r + tmp : r - tmp;
             if (r.is_overflow()) {
-                mStringRepresentation = "inf";
+                SetInfinityState();
                 return;
             }
             if (mNominator.is_nonegative()) {
@@ -215,97 +447,130 @@ class Decimal {
             }
         }
         // Пересчитаем числитель и знаменатель к эталонным.
-        I128 fraction = mNominator.is_negative() ? -mNominator : mNominator;
-        const auto& etalon_denominator = global.mDenominator;
+        Integer fraction = mNominator.abs();
+        const auto& etalon_denominator = Denominator();
+        Integer dropped {0};
         if (etalon_denominator != mChangedDenominator) {
             fraction = fraction * etalon_denominator;
-            if (!fraction.is_singular())
-                std::tie(fraction, std::ignore) = fraction / mChangedDenominator;
-        }
-        if (fraction.is_singular()) { // Улучшаем точность дробной части.
-            // Может возникнуть, например, когда делим два больших сопоставимых числа.
-            fraction = mNominator.is_negative() ? -mNominator : mNominator;
-            if (etalon_denominator < mChangedDenominator) {
-                const auto& scale = (mChangedDenominator / etalon_denominator).first;
-                fraction = (fraction / scale).first;
-            } else
-            if (etalon_denominator > mChangedDenominator && mChangedDenominator.is_positive()) {
-                const auto& [scale, rem] = etalon_denominator / mChangedDenominator;
-                fraction = fraction * scale + ((rem * fraction) / mChangedDenominator).first;
+            if (!fraction.is_singular()) {
+                std::tie(fraction, dropped) = fraction / mChangedDenominator;
+            } else { // Произведение не помещается в Integer (делим два больших сопоставимых числа): считаем в 256 битах.
+                // Числитель меньше знаменателя, поэтому частное меньше эталонного знаменателя.
+                const auto [scaled, rest] = U256::mult_ext(mNominator.abs().unsigned_part(), etalon_denominator.unsigned_part())
+                                                .divrem(mChangedDenominator.unsigned_part());
+                fraction = Integer{scaled.low()};
+                dropped = Integer{rest};
             }
         }
-        // Восстанавливаем эталонные числитель и знаменатель.
-        mNominator = mNominator.is_negative() ? -fraction : fraction;
-        mChangedDenominator = global.mDenominator;
-        // Коррекция всех девяток.
-        if ((global.mWidth > 0) && ((fraction + I128{1}) == mChangedDenominator)) {
-            fraction = I128{0};
-            r += the_sign != 0 ? -I128{1} : I128{1};
-            mNominator = I128{0};
-            mInteger = r;
+        const RoundingMode rounding = GetRounding();
+        // Шаг округления по остатку от приведения к эталонному знаменателю; нечетность - у младшей цифры.
+        if (rounding != RoundingMode::TRUNCATE && !dropped.is_zero()) {
+            const bool odd = ((GetWidth() > 0 ? fraction : r).unsigned_part().low() & 1) != 0;
+            const auto remainder = rounding::Classify(dropped.unsigned_part(), mChangedDenominator.unsigned_part());
+            if (rounding::Increment(rounding, remainder, the_sign != 0, odd))
+                fraction += Integer{1};
+        }
+        mChangedDenominator = Denominator();
+        // Перенос в целую часть после округления; в режиме отбрасывания - коррекция всех девяток.
+        const bool is_carry = rounding == RoundingMode::TRUNCATE ? (GetWidth() > 0) && ((fraction + Integer{1}) == mChangedDenominator)
+                                                                 : fraction == mChangedDenominator;
+        if (is_carry) {
+            fraction = Integer{0};
+            r += the_sign != 0 ? -Integer{1} : Integer{1};
             if (r.is_overflow()) {
-                mStringRepresentation = "inf";
+                SetInfinityState();
                 return;
             }
         }
-        //
-        const int separator_length = global.mWidth < 1 ? 0 : 1;
-        const auto& r_len = u128::utils::num_of_digits(r.unsigned_part());
-        const int required_length = (r_len + separator_length + global.mWidth) + (the_sign != 0 ? 1 : 0);
-        // Целая часть, разделитель, дробная часть (precision), знак.
-        assert(required_length <= Vector128::MaxSize());
-        assert(required_length > 0);
-        mStringRepresentation.Resize(required_length);
-        mStringRepresentation[0] = the_sign != 0 ? chars::minus_sign : mStringRepresentation[0];
-        if (r.is_zero())
-            mStringRepresentation[required_length - global.mWidth - 1 - separator_length] = chars::zero;
         r = r.abs();
         if (r.is_overflow()) {
-            mStringRepresentation = "inf";
+            SetInfinityState();
             return;
         }
-        U128 ru = r.unsigned_part();
-        for (int i = 0; ru != 0 ; i++) {
-            const auto mod10 = (ru % 10u).low();
-            mStringRepresentation[required_length - global.mWidth - 1 - separator_length - i] = DIGITS[mod10];
-            ru /= 10u;
+        // Дробная часть - младшие width цифр.
+        U128 fraction_u = GetWidth() > 0 ? fraction.unsigned_part() : U128{0};
+        const U128 denominator = Denominator().unsigned_part();
+        if (fraction_u >= denominator)
+            fraction_u %= denominator;
+        mInteger = Integer{r.unsigned_part()};
+        mInteger = the_sign != 0 ? -mInteger : mInteger;
+        mNominator = Integer{fraction_u};
+        if (mInteger.is_zero() && the_sign != 0) { // Если целая часть равна нулю, то знак храним в числителе.
+            mNegativeZero = fraction_u == 0;
+            if (GetWidth() > 0)
+                mNominator = -mNominator;
         }
-        if (separator_length > 0)
-            mStringRepresentation[required_length - 1 - global.mWidth] = chars::separator;
-        U128 fraction_u = fraction.unsigned_part();
-        for (int i = 0; i < global.mWidth; i++) {
-            const auto mod10 = (fraction_u % 10u).low();
-            mStringRepresentation[required_length - 1 - i] = DIGITS[mod10];
-            fraction_u /= 10u;
+    }
+
+    /**
+     * @brief Записать каноническое (см. Normalize) значение в строковое представление.
+     * Количество цифр после запятой берется из знаменателя самого числа, а не из текущей ширины.
+     */
+    Vector128 TransformToString() const {
+        Vector128 text;
+        if (IsOverflowed()) {
+            text = "inf";
+            return text;
+        }
+        if (IsNotANumber())
+            return text;
+        const int width = bignum::u128::floor_log10(mChangedDenominator.unsigned_part());
+        // Знак, целая часть, разделитель, дробная часть (precision) пишутся прямо в буфер.
+        char* const first = text.Data();
+        char* out = first;
+        if (IsNegative() || mNegativeZero)
+            *out++ = chars::minus_sign;
+        const auto [integer_end, ec] = bignum::u128::to_chars(out, first + Vector128::MaxSize(), mInteger.unsigned_part());
+        assert(ec == std::errc{});
+        out = integer_end;
+        if (width > 0) {
+            *out++ = chars::separator;
+            bignum::u128::write_digits_backward(out + width, mNominator.unsigned_part().low(), width);
+            out += width;
         }
+        const int required_length = static_cast<int>(out - first);
+        assert(required_length <= Vector128::MaxSize());
+        assert(required_length > 0);
+        text.Resize(required_length);
+        return text;
     }
 
     /**
      * @brief Преобразовать строковое представление числа в компоненты Decimal.
+     * @param text Строковое представление.
      */
-    void TransformToDecimal() {
-        if (mStringRepresentation.RealSize() < 1) {
-            mInteger = I128{0};
-            mNominator = I128{0};
-            mChangedDenominator = I128{0};
+    void TransformToDecimal(const Vector128& text) {
+        if (text.RealSize() < 1) {
+            mInteger = Integer{0};
+            mNominator = Integer{0};
+            mChangedDenominator = Integer{0};
             return;
         }
-        if (mStringRepresentation.GetStringView().starts_with("inf")) {
-            mInteger = -I128{1};
-            mNominator = -I128{1};
+        if (text.GetStringView().starts_with("inf")) {
+            mInteger = -Integer{1};
+            mNominator = -Integer{1};
             return;
         }
-        mNominator = I128{0};
-        mChangedDenominator = global.mDenominator;
-        const int the_sign = mStringRepresentation[0] == chars::minus_sign ? 1 : 0;
+        mNominator = Integer{0};
+        mChangedDenominator = Denominator();
+        const int the_sign = text[0] == chars::minus_sign ? 1 : 0;
         int current_index = the_sign != 0 ? 1 : 0;
-        char digit = mStringRepresentation[current_index];
-        mInteger = I128{0};
-        mInteger = undigits(digit); // В случае некорректного символа возвращается ноль.
-        current_index++;
-        digit = mStringRepresentation[current_index];
-        bool is_overflow = false;
-        while ((digit != chars::separator && digit != chars::alternative_separator) && digit != chars::null) {
+        mInteger = Integer{0};
+        // Сплошной блок цифр целой части разбирается пачками по 16/8 цифр, с одной проверкой переполнения на пачку.
+        const char* const first = text.Data() + current_index;
+        const char* const last = text.Data() + text.RealSize();
+        U128 integer;
+        const auto [digits_end, ec] = bignum::u128::from_chars(first, last, integer);
+        bool is_overflow = ec == std::errc::result_out_of_range;
+        if (ec == std::errc{})
+            mInteger = Integer{integer};
+        current_index += static_cast<int>(digits_end - first);
+        // Первый символ берется безусловно: некорректный символ дает ноль. За концом строки ("-") читать нечего.
+        if (ec == std::errc::invalid_argument && current_index < text.RealSize())
+            current_index++;
+        char digit = text[current_index];
+        // Посторонние символы внутри целой части считаются нулями: этот редкий случай разбирается поштучно.
+        while (!is_overflow && (digit != chars::separator && digit != chars::alternative_separator) && digit != chars::null) {
             if (const auto tmp = mInteger * u64{10}; tmp.is_overflow()) {
                 is_overflow = true;
                 break;
@@ -317,93 +582,399 @@ class Decimal {
             }
             mInteger = mInteger + undigits(digit);
             current_index++;
-            digit = mStringRepresentation[current_index];
+            digit = text[current_index];
         } // while
         if (is_overflow) {
-            mInteger = -I128{1};
-            mNominator = -I128{1};
-            mStringRepresentation = "inf";
+            mInteger = -Integer{1};
+            mNominator = -Integer{1};
             return;
         }
         mInteger = the_sign != 0 ? -mInteger : mInteger;
         if (digit == chars::null)
             return;
         current_index++;
-        digit = mStringRepresentation[current_index];
-        mNominator = mNominator + undigits(digit);
-        current_index++;
-        digit = mStringRepresentation[current_index];
-        const int length = mStringRepresentation.RealSize();
-        int idx_width = 1;
-        while (current_index < length) {
-            if (idx_width >= global.mWidth) // Слишком много цифр после запятой.
-                break;
+        const int length = text.RealSize();
+        int idx_width = 0;
+        while (current_index < length && idx_width < GetWidth()) {
+            digit = text[current_index];
             mNominator = mNominator * u64{10};
             mNominator = mNominator + undigits(digit);
             current_index++;
-            digit = mStringRepresentation[current_index];
             idx_width++;
         }
-        while (idx_width < global.mWidth) { // Добавление нулей. Например 4,5 => 4,50 при width = 2.
+        while (idx_width < GetWidth()) { // Добавление нулей. Например 4,5 => 4,50 при width = 2.
             mNominator = mNominator * u64{10};
-            mNominator = mNominator + I128{0};
+            mNominator = mNominator + Integer{0};
             idx_width++;
         }
+        // Слишком много цифр после запятой: остаток округляется по первой отброшенной цифре
+        // и признаку ненулевых цифр за ней. Перенос в целую часть выполнит Normalize.
+        if (current_index < length && GetRounding() != RoundingMode::TRUNCATE) {
+            const int first_dropped = undigits(text[current_index]);
+            bool is_sticky = false;
+            for (int i = current_index + 1; i < length; ++i)
+                is_sticky |= undigits(text[i]) != 0;
+            const auto remainder = first_dropped > 5 || (first_dropped == 5 && is_sticky) ? rounding::ABOVE_HALF
+                                   : first_dropped == 5                                 ? rounding::HALF
+                                   : first_dropped > 0 || is_sticky                     ? rounding::BELOW_HALF
+                                                                                        : rounding::EXACT;
+            const bool odd = ((GetWidth() > 0 ? mNominator : mInteger).unsigned_part().low() & 1) != 0;
+            if (rounding::Increment(GetRounding(), remainder, the_sign != 0, odd))
+                mNominator = mNominator + Integer{1};
+        }
         if (mInteger.is_zero() && the_sign != 0) // Если целая часть равна нулю, то знак храним в числителе.
             mNominator = -mNominator;
     }
 
-public:
-    explicit Decimal() {
-        TransformToString();
+    /**
+     * @brief Модули целой и дробной частей; дробная часть приводится к знаменателю denominator = 10^k
+     * (лишние знаки отбрасываются).
+     */
+    std::pair<U128, U128> MagnitudeAt(const U128& denominator) const {
+        const U128 own = mChangedDenominator.unsigned_part();
+        U128 fraction = mNominator.unsigned_part();
+        if (own != denominator)
+            fraction = own < denominator ? fraction * (denominator / own) : fraction / (own / denominator);
+        return {mInteger.unsigned_part(), fraction};
     }
 
+    /**
+     * @brief Деление, когда делимое или делитель в масштабе 1/10^width не помещается в Integer:
+     * частное и остаток считаются в 256 битах и округляются в режиме текущего контекста.
+     * @param other Ненулевой конечный делитель.
+     */
+    Decimal DivideWide(const Decimal& other) const {
+        const U128 denominator = Denominator().unsigned_part();
+        const auto [ia, fa] = MagnitudeAt(denominator);
+        const auto [ib, fb] = other.MagnitudeAt(denominator);
+        const U256 dividend = (U256::mult_ext(ia, denominator) + U256{fa}) * U256{denominator}; // < 2^208.
+        const U256 divisor = U256::mult_ext(ib, denominator) + U256{fb};
+        const bool negative = IsNegative() != other.IsNegative();
+        U256 scaled;
+        rounding::Remainder remainder;
+        if (divisor.high() == 0) {
+            const auto [quotient, rest] = dividend.divrem(divisor.low());
+            scaled = quotient;
+            remainder = rounding::Classify(rest, divisor.low());
+        } else { // Делитель не меньше 2^128, поэтому частное меньше 2^80.
+            const auto [quotient, rest] = dividend / divisor;
+            scaled = quotient;
+            remainder = rounding::Classify(rest, divisor);
+        }
+        if (rounding::Increment(GetRounding(), remainder, negative, (scaled.low().low() & 1) != 0))
+            scaled += U256{1};
+        const auto [integer, fraction] = scaled.divrem(denominator);
+        Decimal result;
+        if (integer.high() != 0) {
+            result.SetInfinity();
+            return result;
+        }
+        result.SetMagnitude(negative, Integer{integer.low()}, Integer{fraction});
+        return result;
+    }
+
+    /**
+     * @brief Умножение с отбрасыванием лишних знаков (без коррекции девяток при ином режиме округления).
+     * @param other Второй операнд.
+     * @return Результат умножения двух чисел.
+     */
+    Decimal Multiply(const Decimal& other) const {
+        Decimal result;
+        if (other.IsOverflowed() || this->IsOverflowed()) {
+            result.SetInfinity();
+            return result;
+        }
+        if (other.IsNotANumber() || this->IsNotANumber()) {
+            result.SetNotANumber();
+            return result;
+        }
+        auto integer_part = mInteger * other.mInteger;
+        if (integer_part.is_overflow()) {
+            result.SetInfinity();
+            return result;
+        }
+        const bool all_integers = mNominator.is_zero() && other.mNominator.is_zero();
+        auto fraction_part = integer_part * u64{0};
+        if (all_integers) {
+            result.SetDecimal(integer_part, fraction_part);
+            return result;
+        }
+        const bool neg1 = IsNegative();
+        const bool neg2 = other.IsNegative();
+        const bool left_integer = mNominator.is_zero() && !other.mNominator.is_zero();
+        if (left_integer) {
+            const auto A = mInteger.abs() * other.mNominator.abs();
+            if (A.is_overflow()) {
+                Decimal N; N.SetDecimal( mInteger, Integer{0} ); // Через Decimal вычисляется точно.
+                Decimal M; M.SetDecimal( Denominator(), Integer{0} );
+                Decimal P; P.SetDecimal( other.mNominator, Integer{0} );
+                N = N / M;
+                N = N * P;
+                result.SetDecimal(integer_part, Integer{0});
+                result = result + N;
+                return result;
+            }
+            const auto& [tmp, remainder] = A / Denominator();
+            integer_part += (neg1 ^ neg2) ? -tmp : tmp;
+            fraction_part = A - tmp * Denominator();
+            if (neg1 ^ neg2) {
+                fraction_part = integer_part.is_zero() ? -fraction_part : fraction_part;
+            }
+            result.SetDecimal(integer_part, fraction_part);
+            return result;
+        }
+        const bool right_integer = !mNominator.is_zero() && other.mNominator.is_zero();
+        if (right_integer) {
+            const auto& A = mNominator.abs() * other.mInteger.abs();
+            if (A.is_overflow()) {
+                Decimal N; N.SetDecimal( other.mInteger, Integer{0} ); // Через Decimal вычисляется точно.
+                Decimal M; M.SetDecimal( Denominator(), Integer{0} );
+                Decimal P; P.SetDecimal( mNominator, Integer{0} );
+                N = N / M;
+                N = N * P;
+                result.SetDecimal(integer_part, Integer{0});
+                result = result + N;
+                return result;
+            }
+            const auto& [tmp, remainder] = A / Denominator();
+            integer_part += (neg1 ^ neg2) ? -tmp : tmp;
+            fraction_part = A - tmp * Denominator();
+            if (neg1 ^ neg2) {
+                fraction_part = integer_part.is_zero() ? -fraction_part : fraction_part;
+            }
+            result.SetDecimal(integer_part, fraction_part);
+            return result;
+        }
+        // Оба дробные, и хотя бы один из них имеет ненулевую целую часть.
+        if ((!right_integer && !left_integer) && (!this->mInteger.is_zero() || !other.mInteger.is_zero())) {
+            if (this->mInteger.abs() >= other.mInteger.abs()) {
+                Decimal N; N.SetDecimal(this->mInteger, Integer{0});
+                result = N.Multiply(other);
+                Decimal M; M.SetDecimal(Integer{0}, (this->mInteger.is_negative() ? -this->mNominator : this->mNominator));
+                result = result + M.Multiply(other);
+                return result;
+            } else {
+                Decimal N; N.SetDecimal(other.mInteger, Integer{0});
+                result = N.Multiply(*this);
+                Decimal M; M.SetDecimal(Integer{0}, (other.mInteger.is_negative() ? -other.mNominator : other.mNominator));
+                result = result + M.Multiply(*this);
+                return result;
+            }
+        }
+        if (!neg1 && !neg2) {
+            const auto A = mInteger*other.mNominator + mNominator*other.mInteger + ((mNominator*other.mNominator)/Denominator()).first;
+            if (A.is_overflow()) {
+                result.SetInfinity();
+                return result;
+            }
+            const auto& [tmp, remainder] = A / Denominator();
+            integer_part += tmp;
+            // fraction_part = A - tmp * Denominator();
+            fraction_part = remainder;
+        }
+        if (neg1 && neg2) {
+            const int neg1_strong = IsStrongNegative();
+            const int neg2_strong = other.IsStrongNegative();
+            const int neg1_weak = IsWeakNegative();
+            const int neg2_weak = other.IsWeakNegative();
+            if (neg1_strong && neg2_strong) {
+                const auto& A = mInteger.abs()*other.mNominator + other.mInteger.abs()*mNominator + ((mNominator*other.mNominator)/Denominator()).first;
+                if (A.is_overflow()) {
+                    result.SetInfinity();
+                    return result;
+                }
+                const auto& [tmp, remainder] = A / Denominator();
+                integer_part += tmp;
+                // fraction_part = A - tmp * Denominator();
+                fraction_part = remainder;
+
+            }
+            if (neg1_weak && neg2_strong) {
+                const auto& A = other.mInteger.abs()*mNominator.abs() + ((mNominator.abs()*other.mNominator)/Denominator()).first;
+                if (A.is_overflow()) {
+                    result.SetInfinity();
+                    return result;
+                }
+                const auto [tmp, remainder] = A / Denominator();
+                integer_part += tmp;
+                // fraction_part = A - tmp * Denominator();
+                fraction_part = remainder;
+            }
+            if (neg1_strong && neg2_weak) {
+                const auto& A = mInteger.abs()*other.mNominator.abs() + ((mNominator*other.mNominator.abs())/Denominator()).first;
+                if (A.is_overflow()) {
+                    result.SetInfinity();
+                    return result;
+                }
+                const auto [tmp, remainder] = A / Denominator();
+                integer_part += tmp;
+                // fraction_part = A - tmp * Denominator();
+                fraction_part = remainder;
+            }
+            if (neg1_weak && neg2_weak) {
+                const auto& [A, remainder] = (mNominator.abs()*other.mNominator.abs())/Denominator();
+                if (A.is_overflow()) {
+                    result.SetInfinity();
+                    return result;
+                }
+                const auto& [tmp, remainder2] = A / Denominator();
+                integer_part += tmp;
+                // fraction_part = A - tmp * Denominator();
+                fraction_part = remainder2;
+            }
+        }
+        if (neg1 && !neg2) {
+            const int neg1_strong = IsStrongNegative();
+            const int neg1_weak = IsWeakNegative();
+            if (neg1_strong) {
+                const auto& A = mInteger.abs()*other.mNominator + other.mInteger*mNominator + ((mNominator*other.mNominator)/Denominator()).first;
+                if (A.is_overflow()) {
+                    result.SetInfinity();
+                    return result;
+                }
+                const auto& [tmp, remainder] = A / Denominator();
+                integer_part = integer_part.abs() + tmp;
+                fraction_part = A - tmp * Denominator();
+                integer_part = -integer_part;
+                fraction_part = integer_part.is_zero() ? -fraction_part : fraction_part;
+            }
+            if (neg1_weak) {
+                const auto& A = other.mInteger*mNominator.abs() + ((mNominator.abs()*other.mNominator)/Denominator()).first;
+                if (A.is_overflow()) {
+                    result.SetInfinity();
+                    return result;
+                }
+                const auto& [tmp, remainder] = A / Denominator();
+                integer_part = tmp;
+                fraction_part = A - tmp * Denominator();
+                integer_part = -integer_part;
+                fraction_part = integer_part.is_zero() ? -fraction_part : fraction_part;
+            }
+        }
+        if (!neg1 && neg2) {
+            const int neg2_strong = other.IsStrongNegative();
+            const int neg2_weak = other.IsWeakNegative();
+            if (neg2_strong) {
+                const auto& A = mInteger*other.mNominator + other.mInteger.abs()*mNominator + ((mNominator*other.mNominator)/Denominator()).first;
+                if (A.is_overflow()) {
+                    result.SetInfinity();
+                    return result;
+                }
+                const auto& [tmp, remainder] = A / Denominator();
+                integer_part = integer_part.abs() + tmp;
+                fraction_part = A - tmp * Denominator();
+                integer_part = -integer_part;
+                fraction_part = integer_part.is_zero() ? -fraction_part : fraction_part;
+            }
+            if (neg2_weak) {
+                const auto& A = mInteger*other.mNominator.abs() + ((mNominator*other.mNominator.abs())/Denominator()).first;
+                if (A.is_overflow()) {
+                    result.SetInfinity();
+                    return result;
+                }
+                const auto& [tmp, remainder] = A / Denominator();
+                integer_part = tmp;
+                fraction_part = A - tmp * Denominator();
+                integer_part = -integer_part;
+                fraction_part = integer_part.is_zero() ? -fraction_part : fraction_part;
+            }
+        }
+        result.SetDecimal(integer_part, fraction_part);
+        return result;
+    }
+
+    /**
+     * @brief Увеличить модуль на единицу младшего разряда; знак берется из negative, так как
+     * отброшенное отрицательное значение могло дать ноль.
+     */
+    void IncrementMagnitude(bool negative) {
+        if (GetWidth() > 0)
+            SetMagnitude(negative, mInteger.abs(), mNominator.abs() + Integer{1});
+        else
+            SetMagnitude(negative, mInteger.abs() + Integer{1}, Integer{0});
+    }
+
+    /**
+     * @brief Установить число по знаку и модулям целой и дробной частей.
+     * Перенос дробной части, равной знаменателю, в целую часть выполнит Normalize.
+     */
+    void SetMagnitude(bool negative, const Integer& integer, const Integer& fraction) {
+        if (!negative)
+            SetDecimal(integer, fraction);
+        else if (!integer.is_zero())
+            SetDecimal(-integer, fraction);
+        else // Если целая часть равна нулю, то знак храним в числителе.
+            SetDecimal(Integer{0}, -fraction);
+    }
+
+    friend class DecimalAccumulator;
+    friend class DecimalCodec;
+
+public:
+    explicit Decimal() = default;
+
     Decimal operator-() const {
         Decimal result = *this;
+        if (IsOverflowed() || IsNotANumber())
+            return result;
         if (result.mInteger.is_zero()) {
             result.mNominator = -result.mNominator;
         } else {
             result.mInteger = -result.mInteger;
         }
-        result.TransformToString();
+        result.Normalize();
         return result;
     }
 
     /**
-     * @brief Установить количество знаков после запятой.
+     * @brief Установить количество знаков после запятой в контексте потока по умолчанию.
      * @param width Количество знаков после запятой.
      * @return Произошло ли изменение количества знаков.
      */
-    static bool SetWidth(int width) {
-        int old_width = global.mWidth;
-        global.mWidth = std::clamp(width, 0, global.MAX_WIDTH);
-        global.mDenominator = u128::utils::int_power(10, global.mWidth);
-        return global.mWidth != old_width;
+    static bool SetWidth(int width) {
+        return DecimalContext::ThreadDefault().SetWidth(width);
+    }
+
+    /**
+     * @brief Количество знаков после запятой в текущем контексте потока.
+     */
+    static int GetWidth() {
+        return DecimalContext::Current().Width();
+    }
+
+    /**
+     * @brief Режим округления в текущем контексте потока.
+     */
+    static RoundingMode GetRounding() {
+        return DecimalContext::Current().Rounding();
     }
 
-    static auto GetWidth() {
-        return global.mWidth;
+    /**
+     * @brief Наибольшее количество знаков после запятой.
+     */
+    static constexpr int MaxWidth() {
+        return DecimalContext::MAX_WIDTH;
     }
 
     /**
      * @brief Установить ноль.
      */
     void SetZero() {
-        SetDecimal(I128{0}, I128{0}, global.mDenominator);
+        SetDecimal(Integer{0}, Integer{0}, Denominator());
     }
 
     /**
      * @brief Установить NaN.
      */
     void SetNotANumber() {
-        SetDecimal(I128{0}, I128{0}, I128{0});
+        SetDecimal(Integer{0}, Integer{0}, Integer{0});
     }
 
     /**
      * @brief Установить Inf.
      */
     void SetInfinity() {
-        SetDecimal(-I128{1}, -I128{1});
+        SetDecimal(-Integer{1}, -Integer{1});
     }
 
     /**
@@ -412,13 +983,12 @@ public:
      * @param nominator Числитель дробной части.
      * @param denominator Знаменатель дробной части.
      */
-    void SetDecimal(I128 integer, I128 nominator, I128 denominator = -I128{1}) {
+    void SetDecimal(Integer integer, Integer nominator, Integer denominator = -Integer{1}) {
         mInteger = integer;
         mNominator = nominator;
         mChangedDenominator = denominator;
-        // Сделать прямое-обратное преобразования для формирования знаменателя 10^width.
-        TransformToString();
-        TransformToDecimal();
+        // Привести к знаменателю 10^width; строка будет сформирована при первом чтении.
+        Normalize();
     }
 
     /**
@@ -481,8 +1051,13 @@ public:
         return mInteger.is_zero() && mNominator.is_zero() && mChangedDenominator.is_positive();
     }
 
-    auto ValueAsStringView() const {
-        return mStringRepresentation.GetStringView();
+    /**
+     * @brief Строковое представление числа. Формируется при каждом обращении в возвращаемый по значению
+     * буфер, а не в кэш внутри числа: объект не меняется, поэтому читать его из разных потоков безопасно.
+     * Арифметика строк не касается.
+     */
+    Vector128 ValueAsStringView() const {
+        return TransformToString();
     }
 
     auto IntegerPart() const {
@@ -493,8 +1068,82 @@ public:
         return mNominator;
     }
 
-    static auto Denominator() {
-        return global.mDenominator;
+    /**
+     * @brief Модуль дробной части, приведенный к MaxWidth() знакам: 0,5 при любой ширине дает 5 * 10^11.
+     * Не зависит от ширины, при которой получено число, поэтому годится для сравнения и хеширования.
+     */
+    u64 FractionAtMaxWidth() const {
+        const int width = bignum::u128::floor_log10(mChangedDenominator.unsigned_part());
+        return mNominator.unsigned_part().low() * bignum::u128::pow10(MaxWidth() - width).low();
+    }
+
+    /**
+     * @brief Упорядочение чисел Decimal по значению, без строкового представления:
+     * знак, затем целая часть, затем дробная часть (при разных знаменателях - приведенная к MaxWidth() знакам).
+     * Порядок полный: NaN меньше всех чисел, переполнение (inf) больше всех; NaN эквивалентны
+     * друг другу, как и inf. Отрицательный ноль эквивалентен нулю.
+     * @param lhs Первое число.
+     * @param rhs Второе число.
+     * @return Результат сравнения.
+     */
+    friend std::weak_ordering operator<=>(const Decimal& lhs, const Decimal& rhs) {
+        const auto rank = [](const Decimal& x) { return x.IsOverflowed() ? 2 : x.IsNotANumber() ? 0 : 1; };
+        const int lhs_rank = rank(lhs);
+        const int rhs_rank = rank(rhs);
+        if (lhs_rank != rhs_rank || lhs_rank != 1)
+            return lhs_rank <=> rhs_rank;
+        // Знак канонического числа - в целой части или, если она нулевая, в числителе.
+        const bool negative = lhs.mInteger.is_negative() || lhs.mNominator.is_negative();
+        if (negative != (rhs.mInteger.is_negative() || rhs.mNominator.is_negative()))
+            return negative ? std::weak_ordering::less : std::weak_ordering::greater;
+        auto magnitude = lhs.mInteger.unsigned_part() <=> rhs.mInteger.unsigned_part();
+        if (magnitude == 0) {
+            magnitude = lhs.mChangedDenominator.unsigned_part() == rhs.mChangedDenominator.unsigned_part()
+                            ? lhs.mNominator.unsigned_part() <=> rhs.mNominator.unsigned_part()
+                            : lhs.FractionAtMaxWidth() <=> rhs.FractionAtMaxWidth();
+        }
+        return negative ? 0 <=> magnitude : magnitude;
+    }
+
+    /**
+     * @brief Знаменатель дробной части в текущем контексте потока.
+     */
+    static const Integer& Denominator() {
+        return DecimalContext::Current().Denominator();
+    }
+
+    /**
+     * @brief Округлить до digits знаков после запятой в режиме округления текущего контекста;
+     * младшие знаки обнуляются, результат имеет ширину текущего контекста. Число могло быть получено
+     * при другой ширине (например, DecimalCodec::Decode), поэтому дробная часть читается в собственном
+     * знаменателе числа: шаг округления - деление на 10^(own_width - digits) из таблицы степеней десяти.
+     * @param digits Количество сохраняемых знаков, приводится к отрезку [0, width].
+     */
+    Decimal Rounded(int digits) const {
+        if (IsOverflowed() || IsNotANumber())
+            return *this;
+        const int width = GetWidth();
+        const int own_width = bignum::u128::floor_log10(mChangedDenominator.unsigned_part());
+        digits = std::clamp(digits, 0, width);
+        if (digits == width && own_width == width)
+            return *this;
+        const U128 fraction = mNominator.unsigned_part();
+        U128 kept = fraction;
+        auto remainder = rounding::EXACT;
+        if (own_width <= digits) {
+            kept *= bignum::u128::pow10(digits - own_width);
+        } else {
+            const U128 step = bignum::u128::pow10(own_width - digits);
+            kept = fraction / step;
+            remainder = rounding::Classify(fraction - kept * step, step);
+        }
+        const bool negative = IsNegative();
+        const bool odd = ((digits > 0 ? kept : mInteger.unsigned_part()).low() & 1) != 0;
+        if (rounding::Increment(GetRounding(), remainder, negative, odd))
+            kept += U128{1};
+        Decimal result;
+        result.SetMagnitude(negative, mInteger.abs(), Integer{kept * bignum::u128::pow10(width - digits)});
+        return result;
     }
 
     Decimal Abs() const {
@@ -509,10 +1158,9 @@ public:
      * @brief Установить строковое представление числа.
      * @param str Строковое представление числа.
      */
-    void SetStringRepresentation(const std::string& str) {
-        mStringRepresentation = str;
-        TransformToDecimal();
-        TransformToString();
+    void SetStringRepresentation(std::string_view str) {
+        TransformToDecimal(Vector128{str});
+        Normalize();
     }
 
     /**
@@ -554,11 +1202,11 @@ public:
                 f = -f;
             } else
                 if (f.is_negative() && sum.is_positive()) {
-                    f += global.mDenominator;
+                    f += Denominator();
                     sum -= 1;
                 } else
                     if (f.is_positive() && sum.is_negative()) {
-                        f -= global.mDenominator;
+                        f -= Denominator();
                         sum += 1;
                         if (!sum.is_zero()) {
                             f = f.abs();
@@ -575,9 +1223,7 @@ public:
     }
 
     Decimal operator-(const Decimal& other) const {
-        Decimal res;
-        res.SetDecimal(-other.mInteger, other.mInteger.is_zero() ? -other.mNominator : other.mNominator);
-        return res + *this;
+        return -other + *this;
     }
 
     /**
@@ -585,8 +1231,8 @@ public:
      * @param other Целое число.
      * @return Результат сложения, this + other, с точностью width.
      */
-    Decimal operator+(const I128& other) const {
-        Decimal N; N.SetDecimal( other, I128{0});
+    Decimal operator+(const Integer& other) const {
+        Decimal N; N.SetDecimal( other, Integer{0});
         return *this + N;
     }
 
@@ -595,218 +1241,29 @@ public:
      * @param other Целое число.
      * @return Результат вычитания, this - other, с точностью width.
      */
-    Decimal operator-(const I128& other) const {
-        Decimal N; N.SetDecimal( other, I128{0} );
+    Decimal operator-(const Integer& other) const {
+        Decimal N; N.SetDecimal( other, Integer{0} );
         return *this - N;
     }
 
     /**
      * @brief Оператор умножения двух чисел.
+     * Отброшенная часть произведения - остаток fa*fb по модулю 10^width (fa, fb - дробные части
+     * сомножителей), поэтому шаг округления выполняется по нему, после умножения с отбрасыванием.
      * @param other Второй операнд.
      * @return Результат умножения двух чисел.
      */
     Decimal operator*(const Decimal& other) const {
-        Decimal result;
-        if (other.IsOverflowed() || this->IsOverflowed()) {
-            result.SetInfinity();
-            return result;
-        }
-        if (other.IsNotANumber() || this->IsNotANumber()) {
-            result.SetNotANumber();
-            return result;
-        }
-        auto integer_part = mInteger * other.mInteger;
-        if (integer_part.is_overflow()) {
-            result.SetInfinity();
-            return result;
-        }
-        const bool all_integers = mNominator.is_zero() && other.mNominator.is_zero();
-        auto fraction_part = integer_part * u64{0};
-        if (all_integers) {
-            result.SetDecimal(integer_part, fraction_part);
-            return result;
-        }
-        const bool neg1 = IsNegative();
-        const bool neg2 = other.IsNegative();
-        const bool left_integer = mNominator.is_zero() && !other.mNominator.is_zero();
-        if (left_integer) {
-            const auto A = mInteger.abs() * other.mNominator.abs();
-            if (A.is_overflow()) {
-                Decimal N; N.SetDecimal( mInteger, I128{0} ); // Через Decimal вычисляется точно.
-                Decimal M; M.SetDecimal( global.mDenominator, I128{0} );
-                Decimal P; P.SetDecimal( other.mNominator, I128{0} );
-                N = N / M;
-                N = N * P;
-                result.SetDecimal(integer_part, I128{0});
-                result = result + N;
-                return result;
-            }
-            const auto& [tmp, remainder] = A / global.mDenominator;
-            integer_part += (neg1 ^ neg2) ? -tmp : tmp;
-            fraction_part = A - tmp * global.mDenominator;
-            if (neg1 ^ neg2) {
-                fraction_part = integer_part.is_zero() ? -fraction_part : fraction_part;
-            }
-            result.SetDecimal(integer_part, fraction_part);
-            return result;
-        }
-        const bool right_integer = !mNominator.is_zero() && other.mNominator.is_zero();
-        if (right_integer) {
-            const auto& A = mNominator.abs() * other.mInteger.abs();
-            if (A.is_overflow()) {
-                Decimal N; N.SetDecimal( other.mInteger, I128{0} ); // Через Decimal вычисляется точно.
-                Decimal M; M.SetDecimal( global.mDenominator, I128{0} );
-                Decimal P; P.SetDecimal( mNominator, I128{0} );
-                N = N / M;
-                N = N * P;
-                result.SetDecimal(integer_part, I128{0});
-                result = result + N;
-                return result;
-            }
-            const auto& [tmp, remainder] = A / global.mDenominator;
-            integer_part += (neg1 ^ neg2) ? -tmp : tmp;
-            fraction_part = A - tmp * global.mDenominator;
-            if (neg1 ^ neg2) {
-                fraction_part = integer_part.is_zero() ? -fraction_part : fraction_part;
-            }
-            result.SetDecimal(integer_part, fraction_part);
+        Decimal result = Multiply(other);
+        const RoundingMode rounding = GetRounding();
+        if (rounding == RoundingMode::TRUNCATE || result.IsOverflowed() || result.IsNotANumber())
             return result;
-        }
-        // Оба дробные, и хотя бы один из них имеет ненулевую целую часть.
-        if ((!right_integer && !left_integer) && (!this->mInteger.is_zero() || !other.mInteger.is_zero())) {
-            if (this->mInteger.abs() >= other.mInteger.abs()) {
-                Decimal N; N.SetDecimal(this->mInteger, I128{0});
-                result = N * other;
-                Decimal M; M.SetDecimal(I128{0}, (this->mInteger.is_negative() ? -this->mNominator : this->mNominator));
-                result = result + M * other;
-                return result;
-            } else {
-                Decimal N; N.SetDecimal(other.mInteger, I128{0});
-                result = N * (*this);
-                Decimal M; M.SetDecimal(I128{0}, (other.mInteger.is_negative() ? -other.mNominator : other.mNominator));
-                result = result + M * (*this);
-                return result;
-            }
-        }
-        if (!neg1 && !neg2) {
-            const auto A = mInteger*other.mNominator + mNominator*other.mInteger + ((mNominator*other.mNominator)/global.mDenominator).first;
-            if (A.is_overflow()) {
-                result.SetInfinity();
-                return result;
-            }
-            const auto& [tmp, remainder] = A / global.mDenominator;
-            integer_part += tmp;
-            // fraction_part = A - tmp * global.mDenominator;
-            fraction_part = remainder;
-        }
-        if (neg1 && neg2) {
-            const int neg1_strong = IsStrongNegative();
-            const int neg2_strong = other.IsStrongNegative();
-            const int neg1_weak = IsWeakNegative();
-            const int neg2_weak = other.IsWeakNegative();
-            if (neg1_strong && neg2_strong) {
-                const auto& A = mInteger.abs()*other.mNominator + other.mInteger.abs()*mNominator + ((mNominator*other.mNominator)/global.mDenominator).first;
-                if (A.is_overflow()) {
-                    result.SetInfinity();
-                    return result;
-                }
-                const auto& [tmp, remainder] = A / global.mDenominator;
-                integer_part += tmp;
-                // fraction_part = A - tmp * global.mDenominator;
-                fraction_part = remainder;
-
-            }
-            if (neg1_weak && neg2_strong) {
-                const auto& A = other.mInteger.abs()*mNominator.abs() + ((mNominator.abs()*other.mNominator)/global.mDenominator).first;
-                if (A.is_overflow()) {
-                    result.SetInfinity();
-                    return result;
-                }
-                const auto [tmp, remainder] = A / global.mDenominator;
-                integer_part += tmp;
-                // fraction_part = A - tmp * global.mDenominator;
-                fraction_part = remainder;
-            }
-            if (neg1_strong && neg2_weak) {
-                const auto& A = mInteger.abs()*other.mNominator.abs() + ((mNominator*other.mNominator.abs())/global.mDenominator).first;
-                if (A.is_overflow()) {
-                    result.SetInfinity();
-                    return result;
-                }
-                const auto [tmp, remainder] = A / global.mDenominator;
-                integer_part += tmp;
-                // fraction_part = A - tmp * global.mDenominator;
-                fraction_part = remainder;
-            }
-            if (neg1_weak && neg2_weak) {
-                const auto& [A, remainder] = (mNominator.abs()*other.mNominator.abs())/global.mDenominator;
-                if (A.is_overflow()) {
-                    result.SetInfinity();
-                    return result;
-                }
-                const auto& [tmp, remainder2] = A / global.mDenominator;
-                integer_part += tmp;
-                // fraction_part = A - tmp * global.mDenominator;
-                fraction_part = remainder2;
-            }
-        }
-        if (neg1 && !neg2) {
-            const int neg1_strong = IsStrongNegative();
-            const int neg1_weak = IsWeakNegative();
-            if (neg1_strong) {
-                const auto& A = mInteger.abs()*other.mNominator + other.mInteger*mNominator + ((mNominator*other.mNominator)/global.mDenominator).first;
-                if (A.is_overflow()) {
-                    result.SetInfinity();
-                    return result;
-                }
-                const auto& [tmp, remainder] = A / global.mDenominator;
-                integer_part = integer_part.abs() + tmp;
-                fraction_part = A - tmp * global.mDenominator;
-                integer_part = -integer_part;
-                fraction_part = integer_part.is_zero() ? -fraction_part : fraction_part;
-            }
-            if (neg1_weak) {
-                const auto& A = other.mInteger*mNominator.abs() + ((mNominator.abs()*other.mNominator)/global.mDenominator).first;
-                if (A.is_overflow()) {
-                    result.SetInfinity();
-                    return result;
-                }
-                const auto& [tmp, remainder] = A / global.mDenominator;
-                integer_part = tmp;
-                fraction_part = A - tmp * global.mDenominator;
-                integer_part = -integer_part;
-                fraction_part = integer_part.is_zero() ? -fraction_part : fraction_part;
-            }
-        }
-        if (!neg1 && neg2) {
-            const int neg2_strong = other.IsStrongNegative();
-            const int neg2_weak = other.IsWeakNegative();
-            if (neg2_strong) {
-                const auto& A = mInteger*other.mNominator + other.mInteger.abs()*mNominator + ((mNominator*other.mNominator)/global.mDenominator).first;
-                if (A.is_overflow()) {
-                    result.SetInfinity();
-                    return result;
-                }
-                const auto& [tmp, remainder] = A / global.mDenominator;
-                integer_part = integer_part.abs() + tmp;
-                fraction_part = A - tmp * global.mDenominator;
-                integer_part = -integer_part;
-                fraction_part = integer_part.is_zero() ? -fraction_part : fraction_part;
-            }
-            if (neg2_weak) {
-                const auto& A = mInteger*other.mNominator.abs() + ((mNominator*other.mNominator.abs())/global.mDenominator).first;
-                if (A.is_overflow()) {
-                    result.SetInfinity();
-                    return result;
-                }
-                const auto& [tmp, remainder] = A / global.mDenominator;
-                integer_part = tmp;
-                fraction_part = A - tmp * global.mDenominator;
-                integer_part = -integer_part;
-                fraction_part = integer_part.is_zero() ? -fraction_part : fraction_part;
-            }
-        }
-        result.SetDecimal(integer_part, fraction_part);
+        const U128 denominator = Denominator().unsigned_part();
+        const U128 dropped = (mNominator.unsigned_part() * other.mNominator.unsigned_part()) % denominator;
+        const bool negative = IsNegative() != other.IsNegative();
+        const bool odd = (result.mNominator.unsigned_part().low() & 1) != 0;
+        if (rounding::Increment(rounding, rounding::Classify(dropped, denominator), negative, odd))
+            result.IncrementMagnitude(negative);
         return result;
     }
 
@@ -855,7 +1312,13 @@ public:
             const auto& [div_part, remainder] = A / B;
             const auto& mod_part = A - div_part * B;
             auto integer_part = div_part + (mod_part / B).first;
-            auto [fraction_part, remainder2] = (mNominator.abs() + mod_part * global.mDenominator) / B;
+            auto [fraction_part, remainder2] = (mNominator.abs() + mod_part * Denominator()) / B;
+            if (const RoundingMode rounding = GetRounding(); rounding != RoundingMode::TRUNCATE) {
+                const bool odd = ((GetWidth() > 0 ? fraction_part : integer_part).unsigned_part().low() & 1) != 0;
+                const auto remainder_class = rounding::Classify(remainder2.unsigned_part(), B.unsigned_part());
+                if (rounding::Increment(rounding, remainder_class, neg1 ^ neg2, odd))
+                    fraction_part += Integer{1}; // Перенос в целую часть выполнит Normalize.
+            }
             if (neg1 ^ neg2) {
                 integer_part = integer_part.is_zero() ? integer_part : -integer_part;
                 fraction_part = integer_part.is_zero() ? -fraction_part : fraction_part;
@@ -863,26 +1326,13 @@ public:
             result.SetDecimal(integer_part, fraction_part);
             return result;
         }
-        const bool nominator_has_integer = !mInteger.is_zero();
-        if (nominator_has_integer) {
-            const I128& tmp = mInteger.abs() * global.mDenominator + mNominator.abs();
-            if (tmp.is_overflow()) {
-                Decimal N; N.SetDecimal( mInteger, mNominator );
-                const bool sign = other.IsNegative();
-                const auto& D = other.mNominator.abs() + global.mDenominator*other.mInteger.abs();
-                Decimal M; M.SetDecimal( sign ? -D : D, I128{0} );
-                Decimal P; P.SetDecimal(global.mDenominator, I128{0} );
-                const auto old_N = N;
-                N = N / M; // Точность теряется, вычисляем ошибку E.
-                const auto& E = old_N - N * M;
-                N = N * P;
-                result = N + ((E * P) / M);
-                return result;
-            }
-        }
+        const bool is_wide = (mInteger.abs() * Denominator() + mNominator.abs()).is_singular() ||
+                             (other.mInteger.abs() * Denominator() + other.mNominator.abs()).is_singular();
+        if (is_wide)
+            return DivideWide(other);
         if (!neg1 && !neg2) {
-            const auto& A = mInteger * global.mDenominator + mNominator;
-            const auto& B = other.mInteger * global.mDenominator + other.mNominator;
+            const auto& A = mInteger * Denominator() + mNominator;
+            const auto& B = other.mInteger * Denominator() + other.mNominator;
             const auto& [integer_part, remainder] = A / B;
             const auto& fraction_part = A - integer_part * B;
             result.SetDecimal(integer_part, fraction_part, B);
@@ -893,8 +1343,8 @@ public:
             const int neg1_weak = IsWeakNegative();
             const int neg2_weak = other.IsWeakNegative();
             if (neg1_strong && neg2_strong) {
-                const auto& A = mInteger.abs() * global.mDenominator + mNominator;
-                const auto& B = other.mInteger.abs() * global.mDenominator + other.mNominator;
+                const auto& A = mInteger.abs() * Denominator() + mNominator;
+                const auto& B = other.mInteger.abs() * Denominator() + other.mNominator;
                 const auto& [integer_part, remainder] = A / B;
                 const auto& fraction_part = A - integer_part * B;
                 result.SetDecimal(integer_part, fraction_part, B);
@@ -908,7 +1358,7 @@ public:
                 result.SetDecimal(integer_part, fraction_part, B);
             }
             if (neg1_strong && neg2_weak) {
-                const auto A = mInteger.abs() * global.mDenominator + mNominator;
+                const auto A = mInteger.abs() * Denominator() + mNominator;
                 const auto B = other.mNominator.abs();
                 auto [integer_part, remainder] = A / B;
                 auto fraction_part = A - integer_part * B;
@@ -916,7 +1366,7 @@ public:
             }
             if (neg1_weak && neg2_strong) {
                 const auto& A = mNominator.abs();
-                const auto& B = other.mInteger.abs() * global.mDenominator + other.mNominator;
+                const auto& B = other.mInteger.abs() * Denominator() + other.mNominator;
                 const auto& [integer_part, remainder] = A / B;
                 const auto& fraction_part = A - integer_part * B;
                 result.SetDecimal(integer_part, fraction_part, B);
@@ -926,8 +1376,8 @@ public:
             const int neg1_strong = IsStrongNegative();
             const int neg1_weak = IsWeakNegative();
             if (neg1_strong) {
-                const auto& A = mInteger.abs() * global.mDenominator + mNominator;
-                const auto& B = other.mInteger * global.mDenominator + other.mNominator;
+                const auto& A = mInteger.abs() * Denominator() + mNominator;
+                const auto& B = other.mInteger * Denominator() + other.mNominator;
                 auto [integer_part, remainder] = A / B;
                 auto fraction_part = A - integer_part * B;
                 integer_part = -integer_part;
@@ -936,7 +1386,7 @@ public:
             }
             if (neg1_weak) {
                 const auto& A = mNominator.abs();
-                const auto& B = other.mInteger * global.mDenominator + other.mNominator;
+                const auto& B = other.mInteger * Denominator() + other.mNominator;
                 auto [integer_part, remainder] = A / B;
                 auto fraction_part = A - integer_part * B;
                 integer_part = -integer_part;
@@ -948,8 +1398,8 @@ public:
             const int neg2_strong = other.IsStrongNegative();
             const int neg2_weak = other.IsWeakNegative();
             if (neg2_strong) {
-                const auto& A = mInteger * global.mDenominator + mNominator;
-                const auto& B = other.mInteger.abs() * global.mDenominator + other.mNominator;
+                const auto& A = mInteger * Denominator() + mNominator;
+                const auto& B = other.mInteger.abs() * Denominator() + other.mNominator;
                 auto [integer_part, remainder] = A / B;
                 auto fraction_part = A - integer_part * B;
                 integer_part = -integer_part;
@@ -957,7 +1407,7 @@ public:
                 result.SetDecimal(integer_part, fraction_part, B);
             }
             if (neg2_weak) {
-                const auto& A = mInteger * global.mDenominator + mNominator;
+                const auto& A = mInteger * Denominator() + mNominator;
                 const auto& B = other.mNominator.abs();
                 auto [integer_part, remainder] = A / B;
                 auto fraction_part = A - integer_part * B;
@@ -974,26 +1424,73 @@ public:
      * @param other Делитель.
      * @return Результат деления двух чисел, this / other, с точностью width.
      */
-    Decimal operator/(const I128& other) const {
-        Decimal N; N.SetDecimal( other, I128{0} );
+    Decimal operator/(const Integer& other) const {
+        Decimal N; N.SetDecimal( other, Integer{0} );
         return *this / N;
     }
 };
 
+// Массивы Decimal (QVector, пакеты doItBatch) копируются и перемещаются как память (memcpy).
+static_assert(std::is_trivially_copyable_v<Decimal>);
+
 /**
- * @brief Оператор сравнения чисел Decimal по их строковому представлению.
+ * @brief Равенство чисел Decimal по значению; согласовано с operator<=> и std::hash<Decimal>.
  * @param lhs Первое число.
  * @param rhs Второе число.
  * @return Равны/Не равны.
  */
 bool inline operator==(const Decimal& lhs, const Decimal& rhs) {
-    return lhs.ValueAsStringView() == rhs.ValueAsStringView();
+    return (lhs <=> rhs) == 0;
+}
+
+/**
+ * @brief Запись числа в буфер [first, last) в стиле std::to_chars: то же, что ValueAsStringView.
+ * @return Указатель за последним записанным символом; value_too_large, если буфер мал.
+ */
+inline std::to_chars_result to_chars(char* first, char* last, const Decimal& value) noexcept {
+    const auto text = value.ValueAsStringView();
+    const std::string_view sv = text;
+    if (last - first < static_cast<std::ptrdiff_t>(sv.size()))
+        return {last, std::errc::value_too_large};
+    return {std::copy(sv.begin(), sv.end(), first), std::errc{}};
+}
+
+/**
+ * @brief Разбор записи [-]цифры[(,|.)цифры] из [first, last) в стиле std::from_chars.
+ * Лишние цифры после запятой отбрасываются, как в SetStringRepresentation.
+ * @return Указатель на первый неразобранный символ; invalid_argument, если цифр нет;
+ * result_out_of_range, если целая часть не помещается в 128 бит (value при ошибках не меняется).
+ */
+inline std::from_chars_result from_chars(const char* first, const char* last, Decimal& value) {
+    const auto is_digit = [](char c) { return c >= '0' && c <= '9'; };
+    const char* p = first;
+    if (p != last && *p == chars::minus_sign)
+        ++p;
+    const char* const digits = p;
+    while (p != last && is_digit(*p))
+        ++p;
+    if (p == digits)
+        return {first, std::errc::invalid_argument};
+    if (last - p > 1 && (*p == chars::separator || *p == chars::alternative_separator) && is_digit(p[1])) {
+        p += 2;
+        while (p != last && is_digit(*p))
+            ++p;
+    }
+    Decimal result;
+    result.SetStringRepresentation({first, static_cast<size_t>(p - first)});
+    if (result.IsOverflowed())
+        return {p, std::errc::result_out_of_range};
+    value = result;
+    return {p, std::errc{}};
 }
 
 /**
- * @brief Извлечение квадратного корня.
+ * @brief Извлечение квадратного корня (из модуля числа) напрямую в целых числах:
+ * для масштабированного значения X = |x| * 10^width корень равен isqrt(X * 10^width) в том же масштабе.
+ * Подкоренное выражение не превышает 2^256, корень - 2^128.
  * @param x Число.
- * @param exact Признак, что корень извлекся точно: квадрат даст исходное значение.
+ * Корень округляется в режиме округления текущего контекста.
+ * @param exact Признак, что корень извлекся точно: остаток isqrt равен нулю.
  * @return Квадратный корень числа.
  */
 inline Decimal Sqrt(Decimal x, bool& exact) {
@@ -1005,43 +1502,200 @@ inline Decimal Sqrt(Decimal x, bool& exact) {
         exact = true;
         return x;
     }
-    x = x.Abs();
+    using U256 = bignum::UBig<U128>;
+    const U128 denominator = Decimal::Denominator().unsigned_part();
+    const U256 scaled = U256::mult_ext(x.IntegerPart().unsigned_part(), denominator) + U256{x.Nominator().unsigned_part()};
+    U256 remainder;
+    U128 root = u128::utils::isqrt(scaled * U256{denominator}, &remainder);
+    exact = remainder == U256{0};
+    // Корень лежит между root и root + 1 и не бывает равен root + 1/2: (root + 1/2)^2 = root^2 + root + 1/4.
+    const auto remainder_class = exact ? rounding::EXACT : remainder <= U256{root} ? rounding::BELOW_HALF : rounding::ABOVE_HALF;
+    if (rounding::Increment(Decimal::GetRounding(), remainder_class, false, (root.low() & 1) != 0))
+        root += U128{1};
     Decimal result;
-    // Установка Nominator позволяет извлекать корень из чисел менее 1.
-    result.SetDecimal( u128::utils::isqrt(x.IntegerPart().unsigned_part(), exact), x.Nominator());
-    if (exact && x.Nominator().is_zero()) {
-        return result;
+    result.SetDecimal(Integer{root / denominator}, Integer{root % denominator});
+    return result;
+}
+
+/**
+ * @brief Точный накопитель сумм произведений Decimal с одним округлением в конце.
+ * Числа берутся в масштабе текущего контекста, D = 10^width: x = i + f/D. Произведение
+ * a*b = (ia*ib*D^2 + (ia*fb + fa*ib)*D + fa*fb) / D^2 раскладывается на три группы, каждая из которых
+ * копится в 256 битах без округления; положительные и отрицательные слагаемые копятся раздельно.
+ * Result() округляет лишние знаки (как operator*, по режиму контекста) один раз, для всей суммы.
+ */
+class DecimalAccumulator {
+public:
+    explicit DecimalAccumulator()
+        : mDenominator{Decimal::Denominator().unsigned_part()}
+        , mDivider{mDenominator} {
+    }
+
+    /**
+     * @brief Прибавить точное произведение a*b.
+     */
+    void AddProduct(const Decimal& a, const Decimal& b) {
+        if (!Check(a) || !Check(b))
+            return;
+        const auto [ia, fa] = a.MagnitudeAt(mDenominator);
+        const auto [ib, fb] = b.MagnitudeAt(mDenominator);
+        const U256 integer = U256::mult_ext(ia, ib);
+        if (integer.high() != 0) { // Целая часть произведения не помещается в 128 бит, как и в operator*.
+            mOverflow = true;
+            return;
+        }
+        // Каждое слагаемое меньше 2^168, поэтому суммы в 256 битах не переполняются.
+        Sum& sum = mSum[a.IsNegative() != b.IsNegative()];
+        sum.mIntegers += integer;
+        sum.mCross += U256::mult_ext(ia, fb) + U256::mult_ext(fa, ib);
+        sum.mFractions += U256{fa * fb}; // fa, fb < D <= 10^12.
+    }
+
+    /**
+     * @brief Прибавить число c.
+     */
+    void Add(const Decimal& c) {
+        if (!Check(c))
+            return;
+        const auto [ic, fc] = c.MagnitudeAt(mDenominator);
+        Sum& sum = mSum[c.IsNegative()];
+        sum.mIntegers += U256{ic};
+        sum.mCross += U256{fc};
     }
-    exact = false;
-    Decimal prevprev;
-    prevprev.SetDecimal(-I128{1}, I128{0});
-    auto prev = x;
-    Decimal two;
-    two.SetDecimal(I128{2, 0}, I128{0});
-    for (;;) {
-        prevprev = prev;
-        prev = result;
-        const auto tmp = x / result;
-        if (!tmp.IsOverflowed()) {
-            result = (result + tmp) / two;
-        } else { // Нехватка точности из-за большого количества знаков после запятой: делаем "финт ушами".
-            const auto tmp_r = x / result.IntegerPart();
-            result = (tmp_r + result.IntegerPart()) / two;
+
+    /**
+     * @brief Накопленная сумма, округленная до width знаков в режиме округления текущего контекста.
+     * Переполнение (inf), если модуль суммы положительных или отрицательных слагаемых
+     * не помещается в 256 бит в масштабе 1/D^2, либо целая часть результата - в 128 бит.
+     */
+    Decimal Result() const {
+        Decimal result;
+        if (mOverflow) {
+            result.SetInfinity();
+            return result;
+        }
+        if (mNotANumber) {
+            result.SetNotANumber();
+            return result;
         }
-        if (result.IsZero()) {
-            exact = true;
+        U256 positive;
+        U256 negative;
+        if (!Total(mSum[0], positive) || !Total(mSum[1], negative)) {
+            result.SetInfinity();
             return result;
         }
-        if (result == prev) {
-            exact = (result * result) == x;
+        const bool is_negative = negative > positive;
+        auto [scaled, dropped] = (is_negative ? negative - positive : positive - negative).divrem(mDivider);
+        const auto remainder = rounding::Classify(dropped, mDenominator);
+        if (rounding::Increment(Decimal::GetRounding(), remainder, is_negative, (scaled.low().low() & 1) != 0))
+            scaled += U256{1};
+        const auto [integer, fraction] = scaled.divrem(mDivider);
+        if (integer.high() != 0) {
+            result.SetInfinity();
             return result;
         }
-        if (result == prevprev) {
-            return prev;
+        const Integer integer_part{integer.low()};
+        const Integer fraction_part{fraction};
+        if (!is_negative)
+            result.SetDecimal(integer_part, fraction_part);
+        else if (!integer_part.is_zero())
+            result.SetDecimal(-integer_part, fraction_part);
+        else // Если целая часть равна нулю, то знак храним в числителе.
+            result.SetDecimal(integer_part, -fraction_part);
+        return result;
+    }
+
+private:
+    using U256 = bignum::UBig<U128>;
+
+    /**
+     * @brief Суммы групп слагаемых: целые части ia*ib, перекрестные ia*fb + fa*ib и дробные fa*fb.
+     */
+    struct Sum {
+        U256 mIntegers;
+        U256 mCross;
+        U256 mFractions;
+    };
+
+    /**
+     * @brief Учесть особые значения: переполнение имеет приоритет, как в operator*.
+     * @return Число конечное.
+     */
+    bool Check(const Decimal& x) {
+        if (x.IsOverflowed()) {
+            mOverflow = true;
+            return false;
+        }
+        if (x.IsNotANumber()) {
+            mNotANumber = true;
+            return false;
         }
+        return !mOverflow && !mNotANumber;
+    }
+
+    /**
+     * @brief Сумма в масштабе 1/D^2: (integers*D + cross)*D + fractions.
+     * @return Сумма помещается в 256 бит.
+     */
+    bool Total(const Sum& sum, U256& total) const {
+        if (sum.mIntegers.bit_width() + 2 * U256{mDenominator}.bit_width() > U256::WIDTH - 2)
+            return false;
+        total = (sum.mIntegers * U256{mDenominator} + sum.mCross) * U256{mDenominator} + sum.mFractions;
+        return true;
     }
+
+    U128 mDenominator;
+    bignum::u128::Divider<U128> mDivider;
+
+    /**
+     * @brief Суммы положительных [0] и отрицательных [1] слагаемых.
+     */
+    Sum mSum[2] {};
+
+    bool mOverflow = false;
+    bool mNotANumber = false;
+};
+
+/**
+ * @brief Умножение со сложением a*b + c с одним округлением: произведение не округляется.
+ */
+inline Decimal Fma(const Decimal& a, const Decimal& b, const Decimal& c) {
+    DecimalAccumulator accumulator;
+    accumulator.AddProduct(a, b);
+    accumulator.Add(c);
+    return accumulator.Result();
+}
+
+/**
+ * @brief Скалярное произведение sum(x[i]*y[i]) с одним округлением в конце.
+ * @param x, y Последовательности одинаковой длины.
+ */
+inline Decimal Dot(std::span<const Decimal> x, std::span<const Decimal> y) {
+    assert(x.size() == y.size());
+    DecimalAccumulator accumulator;
+    for (size_t i = 0; i < x.size(); ++i)
+        accumulator.AddProduct(x[i], y[i]);
+    return accumulator.Result();
 }
 
-inline Decimal::_Static Decimal::global;
+}
 
+namespace std {
+/**
+ * @brief Хеш Decimal по значению, согласованный с operator==: равные числа, полученные
+ * при разной ширине, и отрицательный ноль с нулем дают одинаковый хеш.
+ */
+template<>
+struct hash<dec_n::Decimal> {
+    size_t operator()(const dec_n::Decimal& x) const noexcept {
+        if (x.IsOverflowed())
+            return ~size_t{0};
+        if (x.IsNotANumber())
+            return 0;
+        // Комбинируем хеши частей (алгоритм из Boost)
+        size_t h = std::hash<bignum::u128::U128>{}(x.IntegerPart().unsigned_part());
+        h ^= std::hash<uint64_t>{}(x.FractionAtMaxWidth()) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        return x.IsNegative() ? ~h : h;
+    }
+};
 }
@@ -0,0 +1,936 @@
+#pragma once
+
+#include <array>     // std::array
+#include "decimal.h"
+
+namespace dec_n {
+
+/**
+ * @brief Вычисления в фиксированной точке для элементарных функций Decimal.
+ * Значение v хранится как целое v * 2^192 в UBig<U128> (256 бит); знак хранится отдельно.
+ * 192 бита дробной части дают запас более 2^-160 относительной точности даже для результатов
+ * с целой частью до 2^128 и 12 знаками после запятой.
+ */
+namespace math {
+
+using U256 = bignum::UBig<U128>;
+
+inline constexpr uint32_t FRACTION_BITS = 192;
+
+/**
+ * @brief Константа из четырех 64-битных слов, старшее - первое.
+ */
+constexpr U256 Fixed(u64 w3, u64 w2, u64 w1, u64 w0) {
+    return U256{U128{w0, w1}, U128{w2, w3}};
+}
+
+inline constexpr U256 ONE = Fixed(1, 0, 0, 0);
+
+/**
+ * @brief Знаменатель Decimal при наибольшей ширине: аргументы читаются через FractionAtMaxWidth()
+ * и не зависят от ширины, при которой получены.
+ */
+inline constexpr bignum::u128::Divider<U128> MAX_DENOMINATOR{bignum::u128::pow10(Decimal::MaxWidth())};
+
+/**
+ * @brief Таблицы 1 / n! и 1 / n в фиксированной точке: коэффициенты рядов.
+ */
+inline constexpr auto INV_FACTORIALS = [] {
+    std::array<U256, 24> table{};
+    U128 factorial{1};
+    for (u64 n = 0; n < table.size(); ++n) {
+        factorial = n > 0 ? factorial * U128{n} : factorial;
+        table[n] = ONE.divrem(bignum::u128::Divider<U128>{factorial}).first;
+    }
+    return table;
+}();
+
+inline constexpr auto INVERSES = [] {
+    std::array<U256, 33> table{};
+    for (u64 n = 1; n < table.size(); ++n)
+        table[n] = ONE.divrem(bignum::u128::Divider<U128>{U128{n}}).first;
+    return table;
+}();
+
+/**
+ * @brief ln(2).
+ */
+inline constexpr U256 LN2 = Fixed(0x0000000000000000, 0xb17217f7d1cf79ab, 0xc9e3b39803f2f6af, 0x40f343267298b62e);
+
+/**
+ * @brief 1 / ln(2).
+ */
+inline constexpr U256 INV_LN2 = Fixed(0x0000000000000001, 0x71547652b82fe177, 0x7d0ffda0d23a7d11, 0xd6aef551bad2b4b1);
+
+/**
+ * @brief ln(10).
+ */
+inline constexpr U256 LN10 = Fixed(0x0000000000000002, 0x4d763776aaa2b05b, 0xa95b58ae0b4c28a3, 0x8a3fb3e76977e43a);
+
+/**
+ * @brief pi / 2, округлено вниз (см. ReduceQuarterPi).
+ */
+inline constexpr U256 PI_2 = Fixed(0x0000000000000001, 0x921fb54442d18469, 0x898cc51701b839a2, 0x52049c1114cf98e8);
+
+/**
+ * @brief 2 / pi * 2^128, округлено вниз: оценка номера четверти.
+ */
+inline constexpr U128 TWO_OVER_PI_128{0xfc2757d1f534ddc0ull, 0xa2f9836e4e441529ull};
+
+/**
+ * @brief exp(j / 64), j = 0..44.
+ */
+inline constexpr std::array<U256, 45> EXP_TABLE {{
+    Fixed(0x0000000000000001, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000),
+    Fixed(0x0000000000000001, 0x04080ab55de3917a, 0xb864b3e9044e6b45, 0x6f21041f46276ecb),
+    Fixed(0x0000000000000001, 0x08205601127ec98e, 0x0bd083aba80c97a6, 0xaa5017852446806b),
+    Fixed(0x0000000000000001, 0x0c49236829e8bc29, 0x2cfe63d64b295ea1, 0xda758b460877c903),
+    Fixed(0x0000000000000001, 0x1082b577d34ed7d5, 0xb1a019e225c9a951, 0xba29557587c246f9),
+    Fixed(0x0000000000000001, 0x14cd4fc989cd6455, 0x5ea19c6e279c5e0a, 0x6409a56a4a4b216c),
+    Fixed(0x0000000000000001, 0x192937074e0cd689, 0x3d18cdba80eabc29, 0xe7b47b51d4d864e8),
+    Fixed(0x0000000000000001, 0x1d96b0eff0e793d1, 0x58f49a640d8602be, 0xec5365b4d4722460),
+    Fixed(0x0000000000000001, 0x2216045b6f5ccf9c, 0xed688384e06b8d42, 0x78bf0c84a957057d),
+    Fixed(0x0000000000000001, 0x26a7793f601642b5, 0xd730c0089a0e0b24, 0xcec78fd0c6ad8071),
+    Fixed(0x0000000000000001, 0x2b4b58b372c79501, 0x3767c0c59d7d934a, 0x6542ec4461ea8a1e),
+    Fixed(0x0000000000000001, 0x3001ecf601af700b, 0xd5c89634fff557c6, 0xe8b1333eec8093e4),
+    Fixed(0x0000000000000001, 0x34cb8170b58352d4, 0xe0c48cb7c6649345, 0x08e6b0a713048f18),
+    Fixed(0x0000000000000001, 0x39a862bd3c1065f7, 0x469e72f43f077551, 0x4cc9ba2095e8d5e9),
+    Fixed(0x0000000000000001, 0x3e98deaa11dcbaa3, 0x77bdc040c05156d7, 0x577607602144b394),
+    Fixed(0x0000000000000001, 0x439d443f5f158ee3, 0xa4d178ca5bd3e80f, 0xe90c7bf9cfffff22),
+    Fixed(0x0000000000000001, 0x48b5e3c3e8186676, 0x7bc3b69baabe534e, 0xc43887164bbe2b0b),
+    Fixed(0x0000000000000001, 0x4de30ec211e6013b, 0x5223eca17126a038, 0x30a701aa4d36afdf),
+    Fixed(0x0000000000000001, 0x5325180cfacf76ca, 0x2d982992369fb64e, 0xc646587d37f41422),
+    Fixed(0x0000000000000001, 0x587c53c5a7af0276, 0x1d27802f26de5f41, 0x8835c042453bbe2a),
+    Fixed(0x0000000000000001, 0x5de9176045ff53b5, 0x13246531754403c2, 0x9db2c2f00cf3270c),
+    Fixed(0x0000000000000001, 0x636bb9a9832584d2, 0x730c7dc9233c2623, 0xd0ec2842d41014ef),
+    Fixed(0x0000000000000001, 0x690492cbf9432cfd, 0xaf98105237a74b30, 0xb936a6273bc12eee),
+    Fixed(0x0000000000000001, 0x6eb3fc55b1e75b49, 0xd64cdddcbf31037f, 0x5cef67b0dce1090d),
+    Fixed(0x0000000000000001, 0x747a513dbef6a623, 0x478b659b092405c5, 0x78fa421f34b8db7e),
+    Fixed(0x0000000000000001, 0x7a57ede9ea23de33, 0xfb5db6e12f5900e9, 0x77c8013bc9482dea),
+    Fixed(0x0000000000000001, 0x804d30347b545cba, 0xcb9bb718894bd9d4, 0xcb5480a7c268e809),
+    Fixed(0x0000000000000001, 0x865a7772164c5415, 0xdc21ba14a55a2729, 0x2e78463e76ce654c),
+    Fixed(0x0000000000000001, 0x8c802477b000fdc2, 0x4db40ed853110bef, 0x137e20cf0aa4fdf2),
+    Fixed(0x0000000000000001, 0x92be99a09beffb73, 0x37fcf9d3f3c9f50b, 0x1833b8a3d5657a3f),
+    Fixed(0x0000000000000001, 0x99163ad4b1dcc137, 0x18f70534e8a0292e, 0xa8221fb3532d5374),
+    Fixed(0x0000000000000001, 0x9f876d8e8c566505, 0x817ebd721981e9d1, 0xdc653b84f1931058),
+    Fixed(0x0000000000000001, 0xa61298e1e069bc97, 0x2dfefab6df33f9b1, 0xf651f16c130b475a),
+    Fixed(0x0000000000000001, 0xacb82581eee54531, 0xb7d93e1447e769c6, 0x59ac01750fa37b17),
+    Fixed(0x0000000000000001, 0xb3787dc80f95ea2e, 0xcce1d7062a8356bf, 0xec2b8d9bce09fd4e),
+    Fixed(0x0000000000000001, 0xba540dba56e55e96, 0xf0139e3835c04cf7, 0x54740f927035210a),
+    Fixed(0x0000000000000001, 0xc14b431256446443, 0x2aa513ba422005eb, 0x74c2ffc3e7e9ea8f),
+    Fixed(0x0000000000000001, 0xc85e8d43f7cd07ba, 0x28c206608004f307, 0x1f5f71b07b2f8a71),
+    Fixed(0x0000000000000001, 0xcf8e5d84758a8b7e, 0xcd8e944dd9989764, 0xb079a776decf1995),
+    Fixed(0x0000000000000001, 0xd6db26d16cd677e3, 0x8effa297122a7d70, 0x9600a7a284f6b23b),
+    Fixed(0x0000000000000001, 0xde455df80e3c05ca, 0x897b072f6daa5bc5, 0x942e1ee80a070fe1),
+    Fixed(0x0000000000000001, 0xe5cd799c6a54e322, 0x4a85f511ba8fb8c8, 0x824c8db23054f5c7),
+    Fixed(0x0000000000000001, 0xed73f240dc141f87, 0x57b1c4dffda4cc8a, 0xb8077eb06c809844),
+    Fixed(0x0000000000000001, 0xf539424d90f5e657, 0x6d1cf4ae770982ce, 0x91e8ea7c708377a7),
+    Fixed(0x0000000000000001, 0xfd1de6182f8c89d2, 0xc3b6d08c65972242, 0x24e114f55b04c764),
+}};
+
+/**
+ * @brief Приближения 1 / (1 + j / 64) сверху, j = 0..63.
+ */
+inline constexpr std::array<U256, 64> LN_RECIPROCALS {{
+    Fixed(0x0000000000000001, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000),
+    Fixed(0x0000000000000000, 0xfc0fc0fc0fc0fc0f, 0xc0fc0fc0fc0fc0fc, 0x0fc0fc0fc0fc0fc1),
+    Fixed(0x0000000000000000, 0xf83e0f83e0f83e0f, 0x83e0f83e0f83e0f8, 0x3e0f83e0f83e0f84),
+    Fixed(0x0000000000000000, 0xf4898d5f85bb3950, 0x3d226357e16ece54, 0x0f4898d5f85bb396),
+    Fixed(0x0000000000000000, 0xf0f0f0f0f0f0f0f0, 0xf0f0f0f0f0f0f0f0, 0xf0f0f0f0f0f0f0f1),
+    Fixed(0x0000000000000000, 0xed7303b5cc0ed730, 0x3b5cc0ed7303b5cc, 0x0ed7303b5cc0ed74),
+    Fixed(0x0000000000000000, 0xea0ea0ea0ea0ea0e, 0xa0ea0ea0ea0ea0ea, 0x0ea0ea0ea0ea0ea1),
+    Fixed(0x0000000000000000, 0xe6c2b4481cd85689, 0x039b0ad12073615a, 0x240e6c2b4481cd86),
+    Fixed(0x0000000000000000, 0xe38e38e38e38e38e, 0x38e38e38e38e38e3, 0x8e38e38e38e38e39),
+    Fixed(0x0000000000000000, 0xe070381c0e070381, 0xc0e070381c0e0703, 0x81c0e070381c0e08),
+    Fixed(0x0000000000000000, 0xdd67c8a60dd67c8a, 0x60dd67c8a60dd67c, 0x8a60dd67c8a60dd7),
+    Fixed(0x0000000000000000, 0xda740da740da740d, 0xa740da740da740da, 0x740da740da740da8),
+    Fixed(0x0000000000000000, 0xd79435e50d79435e, 0x50d79435e50d7943, 0x5e50d79435e50d7a),
+    Fixed(0x0000000000000000, 0xd4c77b03531dec0d, 0x4c77b03531dec0d4, 0xc77b03531dec0d4d),
+    Fixed(0x0000000000000000, 0xd20d20d20d20d20d, 0x20d20d20d20d20d2, 0x0d20d20d20d20d21),
+    Fixed(0x0000000000000000, 0xcf6474a8819ec8e9, 0x51033d91d2a2067b, 0x23a5440cf6474a89),
+    Fixed(0x0000000000000000, 0xcccccccccccccccc, 0xcccccccccccccccc, 0xcccccccccccccccd),
+    Fixed(0x0000000000000000, 0xca4587e6b74f0329, 0x161f9add3c0ca458, 0x7e6b74f0329161fa),
+    Fixed(0x0000000000000000, 0xc7ce0c7ce0c7ce0c, 0x7ce0c7ce0c7ce0c7, 0xce0c7ce0c7ce0c7d),
+    Fixed(0x0000000000000000, 0xc565c87b5f9d4d1b, 0xc2503159721ed7e7, 0x5346f0940c565c88),
+    Fixed(0x0000000000000000, 0xc30c30c30c30c30c, 0x30c30c30c30c30c3, 0x0c30c30c30c30c31),
+    Fixed(0x0000000000000000, 0xc0c0c0c0c0c0c0c0, 0xc0c0c0c0c0c0c0c0, 0xc0c0c0c0c0c0c0c1),
+    Fixed(0x0000000000000000, 0xbe82fa0be82fa0be, 0x82fa0be82fa0be82, 0xfa0be82fa0be82fb),
+    Fixed(0x0000000000000000, 0xbc52640bc52640bc, 0x52640bc52640bc52, 0x640bc52640bc5265),
+    Fixed(0x0000000000000000, 0xba2e8ba2e8ba2e8b, 0xa2e8ba2e8ba2e8ba, 0x2e8ba2e8ba2e8ba3),
+    Fixed(0x0000000000000000, 0xb81702e05c0b8170, 0x2e05c0b81702e05c, 0x0b81702e05c0b818),
+    Fixed(0x0000000000000000, 0xb60b60b60b60b60b, 0x60b60b60b60b60b6, 0x0b60b60b60b60b61),
+    Fixed(0x0000000000000000, 0xb40b40b40b40b40b, 0x40b40b40b40b40b4, 0x0b40b40b40b40b41),
+    Fixed(0x0000000000000000, 0xb21642c8590b2164, 0x2c8590b21642c859, 0x0b21642c8590b217),
+    Fixed(0x0000000000000000, 0xb02c0b02c0b02c0b, 0x02c0b02c0b02c0b0, 0x2c0b02c0b02c0b03),
+    Fixed(0x0000000000000000, 0xae4c415c9882b931, 0x0572620ae4c415c9, 0x882b9310572620af),
+    Fixed(0x0000000000000000, 0xac7691840ac76918, 0x40ac7691840ac769, 0x1840ac7691840ac8),
+    Fixed(0x0000000000000000, 0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaaa, 0xaaaaaaaaaaaaaaab),
+    Fixed(0x0000000000000000, 0xa8e83f5717c0a8e8, 0x3f5717c0a8e83f57, 0x17c0a8e83f5717c1),
+    Fixed(0x0000000000000000, 0xa72f05397829cbc1, 0x4e5e0a72f0539782, 0x9cbc14e5e0a72f06),
+    Fixed(0x0000000000000000, 0xa57eb50295fad40a, 0x57eb50295fad40a5, 0x7eb50295fad40a58),
+    Fixed(0x0000000000000000, 0xa3d70a3d70a3d70a, 0x3d70a3d70a3d70a3, 0xd70a3d70a3d70a3e),
+    Fixed(0x0000000000000000, 0xa237c32b16cfd772, 0x0f353a4c0a237c32, 0xb16cfd7720f353a5),
+    Fixed(0x0000000000000000, 0xa0a0a0a0a0a0a0a0, 0xa0a0a0a0a0a0a0a0, 0xa0a0a0a0a0a0a0a1),
+    Fixed(0x0000000000000000, 0x9f1165e7254813e2, 0x2cbce4a9027c4597, 0x9c95204f88b2f393),
+    Fixed(0x0000000000000000, 0x9d89d89d89d89d89, 0xd89d89d89d89d89d, 0x89d89d89d89d89d9),
+    Fixed(0x0000000000000000, 0x9c09c09c09c09c09, 0xc09c09c09c09c09c, 0x09c09c09c09c09c1),
+    Fixed(0x0000000000000000, 0x9a90e7d95bc609a9, 0x0e7d95bc609a90e7, 0xd95bc609a90e7d96),
+    Fixed(0x0000000000000000, 0x991f1a515885fb37, 0x072d753bd02647c6, 0x9456217ecdc1cb5e),
+    Fixed(0x0000000000000000, 0x97b425ed097b425e, 0xd097b425ed097b42, 0x5ed097b425ed097c),
+    Fixed(0x0000000000000000, 0x964fda6c0964fda6, 0xc0964fda6c0964fd, 0xa6c0964fda6c0965),
+    Fixed(0x0000000000000000, 0x94f2094f2094f209, 0x4f2094f2094f2094, 0xf2094f2094f20950),
+    Fixed(0x0000000000000000, 0x939a85c40939a85c, 0x40939a85c40939a8, 0x5c40939a85c4093a),
+    Fixed(0x0000000000000000, 0x9249249249249249, 0x2492492492492492, 0x4924924924924925),
+    Fixed(0x0000000000000000, 0x90fdbc090fdbc090, 0xfdbc090fdbc090fd, 0xbc090fdbc090fdbd),
+    Fixed(0x0000000000000000, 0x8fb823ee08fb823e, 0xe08fb823ee08fb82, 0x3ee08fb823ee08fc),
+    Fixed(0x0000000000000000, 0x8e78356d1408e783, 0x56d1408e78356d14, 0x08e78356d1408e79),
+    Fixed(0x0000000000000000, 0x8d3dcb08d3dcb08d, 0x3dcb08d3dcb08d3d, 0xcb08d3dcb08d3dcc),
+    Fixed(0x0000000000000000, 0x8c08c08c08c08c08, 0xc08c08c08c08c08c, 0x08c08c08c08c08c1),
+    Fixed(0x0000000000000000, 0x8ad8f2fba9386822, 0xb63cbeea4e1a08ad, 0x8f2fba9386822b64),
+    Fixed(0x0000000000000000, 0x89ae4089ae4089ae, 0x4089ae4089ae4089, 0xae4089ae4089ae41),
+    Fixed(0x0000000000000000, 0x8888888888888888, 0x8888888888888888, 0x8888888888888889),
+    Fixed(0x0000000000000000, 0x8767ab5f34e47ef1, 0x30a9419637021d9e, 0xad7cd391fbc4c2a6),
+    Fixed(0x0000000000000000, 0x864b8a7de6d1d608, 0x64b8a7de6d1d6086, 0x4b8a7de6d1d60865),
+    Fixed(0x0000000000000000, 0x8534085340853408, 0x5340853408534085, 0x3408534085340854),
+    Fixed(0x0000000000000000, 0x8421084210842108, 0x4210842108421084, 0x2108421084210843),
+    Fixed(0x0000000000000000, 0x83126e978d4fdf3b, 0x645a1cac083126e9, 0x78d4fdf3b645a1cb),
+    Fixed(0x0000000000000000, 0x8208208208208208, 0x2082082082082082, 0x0820820820820821),
+    Fixed(0x0000000000000000, 0x8102040810204081, 0x0204081020408102, 0x0408102040810205),
+}};
+
+/**
+ * @brief -ln(LN_RECIPROCALS[j]): точные логарифмы хранимых приближений.
+ */
+inline constexpr std::array<U256, 64> LN_TABLE {{
+    Fixed(0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000),
+    Fixed(0x0000000000000000, 0x03f815161f807c79, 0xf3db4e9a6f57aadb, 0xeb03be903ddc5336),
+    Fixed(0x0000000000000000, 0x07e0a6c39e0cc013, 0x3e3f04f1ef229fae, 0xaefae14cddf35ad2),
+    Fixed(0x0000000000000000, 0x0bba2c7b196e7e23, 0x1a7950f7252c163c, 0x9bf701b2a89d8caf),
+    Fixed(0x0000000000000000, 0x0f85186008b15330, 0xbe64b8b775997898, 0xd3474d3375b52596),
+    Fixed(0x0000000000000000, 0x1341d7961bd1d092, 0x998376104d137502, 0x1a0eca5b78467950),
+    Fixed(0x0000000000000000, 0x16f0d28ae56b4b9b, 0xe499b9ed19b640ce, 0x50c1ef65087fdf23),
+    Fixed(0x0000000000000000, 0x1a926d3a4ad56365, 0x0bd22a9c3aa4c79a, 0x9f67e22ed398d01d),
+    Fixed(0x0000000000000000, 0x1e27076e2af2e5e9, 0xea87ffe1fe9e155d, 0xb94ebc4017f6f958),
+    Fixed(0x0000000000000000, 0x21aefcf9a11cb2cd, 0x2ee2f481855d1c48, 0x4cb4fd8d03860ef7),
+    Fixed(0x0000000000000000, 0x252aa5f03fea4698, 0x0bb8e203edf4d109, 0xfbc9070f7e29fbad),
+    Fixed(0x0000000000000000, 0x289a56d996fa3ccf, 0xa7b2a1f0fc3c1882, 0xcaf99174f60aa4f7),
+    Fixed(0x0000000000000000, 0x2bfe60e14f27a790, 0xe7c4140e424775fc, 0xd55c7355fdf3e631),
+    Fixed(0x0000000000000000, 0x2f57120421b21237, 0xc6d65ad40c100c8f, 0xfc2929b1021656ae),
+    Fixed(0x0000000000000000, 0x32a4b539e8ad68ec, 0x8260ea71712cec4c, 0xa0bed3cf71766947),
+    Fixed(0x0000000000000000, 0x35e7929d017fe5b1, 0x9cc0326f99eb9767, 0x69b8b9a5d50ca149),
+    Fixed(0x0000000000000000, 0x391fef8f35344358, 0x4bb03de5ff734495, 0xc765ea7411adc1b1),
+    Fixed(0x0000000000000000, 0x3c4e0edc55e5cbd3, 0xd50fffc3fd3c2abb, 0x729d78802fedf2af),
+    Fixed(0x0000000000000000, 0x3f7230dabc7c551a, 0xaa8cd86f29a59412, 0x40584455b22c817b),
+    Fixed(0x0000000000000000, 0x428c9389ce438d7d, 0xcfde8061c030e28d, 0xe035afbe0972de36),
+    Fixed(0x0000000000000000, 0x459d72aeae98380e, 0x731f55c41b8b823f, 0x067d04a43c19f534),
+    Fixed(0x0000000000000000, 0x48a507ef3de59689, 0x0a14f69d750cbd2e, 0x9aad37a78762e748),
+    Fixed(0x0000000000000000, 0x4ba38aeb8474c270, 0xb3246a14206cf37b, 0x77ad6fb226f15212),
+    Fixed(0x0000000000000000, 0x4e993155a517a71c, 0xbcd735d034237d6f, 0x479dcfc053c8dc25),
+    Fixed(0x0000000000000000, 0x51862f08717b09f4, 0x2decdeccf1cd1057, 0x72cd24c00b44393d),
+    Fixed(0x0000000000000000, 0x546ab61cb7e0b427, 0x24f5833eabc623a9, 0xe9e6af97f5c12be1),
+    Fixed(0x0000000000000000, 0x5746f6fd60272942, 0x36383dc7fe1159f3, 0x80b4a6b429a4bb09),
+    Fixed(0x0000000000000000, 0x5a1b207a6c52bb11, 0x0af840538e1a592d, 0xeded1c3395996524),
+    Fixed(0x0000000000000000, 0x5ce75fdaef401a73, 0x89314feb4fbde5aa, 0xdde10dcea59757bb),
+    Fixed(0x0000000000000000, 0x5fabe0ee0abf0d92, 0xce979ed295043716, 0x0cbfcbf71ee8d4b3),
+    Fixed(0x0000000000000000, 0x6268ce1b05096ad6, 0x9c620440f055b3ff, 0xc63281b40515a31e),
+    Fixed(0x0000000000000000, 0x651e5070845beae9, 0x337451f441baba92, 0x9cc25dca0fa1a7e2),
+    Fixed(0x0000000000000000, 0x67cc8fb2fe612fca, 0xda35d9bd01488606, 0x7d20ffb34547d7c2),
+    Fixed(0x0000000000000000, 0x6a73b26a68212635, 0x213fd4bc950d7be1, 0x1fc8ee26768c44e9),
+    Fixed(0x0000000000000000, 0x6d13ddef323d8a32, 0xfbb6aba63878ef20, 0x53ab4d08603cf110),
+    Fixed(0x0000000000000000, 0x6fad36769c6defde, 0x1874deaef06b25b5, 0x2c1be100233b3294),
+    Fixed(0x0000000000000000, 0x723fdf1e6a6886b0, 0x97607bcbfee6892b, 0x8ecbd4e8235b8362),
+    Fixed(0x0000000000000000, 0x74cbf9f803af5587, 0x7b232fafa36fd18a, 0xb4dff5efd6e583ff),
+    Fixed(0x0000000000000000, 0x7751a813071282fb, 0x989a927476e1fe9f, 0x50684ce6bafcfd59),
+    Fixed(0x0000000000000000, 0x79d109875a1e1f8d, 0xf68dbcf2ed1bb404, 0xa18e2aa5ee015120),
+    Fixed(0x0000000000000000, 0x7c4a3d7ebc1bb2cd, 0x720ec44c73d75cf5, 0x649117429ec747b1),
+    Fixed(0x0000000000000000, 0x7ebd623de3cc7b66, 0xbecf93aa1afec6d4, 0xcde2ef184dc7b6e6),
+    Fixed(0x0000000000000000, 0x812a952d2e87f634, 0xe34aebf73ffe346e, 0x4b8b8c4c34ebb89e),
+    Fixed(0x0000000000000000, 0x8391f2e0e6fa0272, 0xbcb1c488b755b2b7, 0xa5d75211210f75cd),
+    Fixed(0x0000000000000000, 0x85f39721295415b4, 0xc4bdd99effe69b64, 0x366fbbf35d3ed119),
+    Fixed(0x0000000000000000, 0x884f9cf16a64b7ef, 0x1f64d85bc8c5f241, 0x63e6f9907e4ae139),
+    Fixed(0x0000000000000000, 0x8aa61e97a6af4d4c, 0x799d1cb2f14054ed, 0x3a330f341cf1faed),
+    Fixed(0x0000000000000000, 0x8cf735a33e4b7662, 0xe5eebbc0ef3d5710, 0x78ea06c2c371d36f),
+    Fixed(0x0000000000000000, 0x8f42faf3820681ef, 0x62cd2f9f1e35f2e7, 0xca4f4817696ad39f),
+    Fixed(0x0000000000000000, 0x918986bdf5fa1416, 0xf1b439165240a471, 0xbcdfcc1f5b0c6c5f),
+    Fixed(0x0000000000000000, 0x93caf0944d88d75b, 0xc1f9edcb438ffc03, 0x527d7309433bbdf4),
+    Fixed(0x0000000000000000, 0x96074f6a24745dcb, 0xd4e18dd14f312a40, 0xa546f842b745196c),
+    Fixed(0x0000000000000000, 0x983eb99a7885f0fd, 0xac850fab36cdee18, 0x0b7013338119ba90),
+    Fixed(0x0000000000000000, 0x9a7144ece70e98b7, 0x5c96c42e72757253, 0x1ddfd382b6be4109),
+    Fixed(0x0000000000000000, 0x9c9f069ab150cd4e, 0x221301b6f8c38f62, 0x1717c9e700413260),
+    Fixed(0x0000000000000000, 0x9ec813538ab7d520, 0x2131e85693cf6b80, 0x9d96954adf1ff935),
+    Fixed(0x0000000000000000, 0xa0ec7f4233957323, 0x25e617a300bbca9c, 0x4486ea2756f59973),
+    Fixed(0x0000000000000000, 0xa30c5e10e2f613e8, 0x5bd9bd99e39a20ae, 0xe59a498016887278),
+    Fixed(0x0000000000000000, 0xa527c2ed81f5d811, 0x3dfa3d3761b6316e, 0x6f7191d8af47e744),
+    Fixed(0x0000000000000000, 0xa73ec08dbadd84e5, 0x84c2b22c2aee1a18, 0xbd794408f774593c),
+    Fixed(0x0000000000000000, 0xa9516932de2d5773, 0xbe4578ad97aea7be, 0xd0920f6a4c39b31d),
+    Fixed(0x0000000000000000, 0xab5fcead9f9cca08, 0xe310b9b1fe59cdc1, 0x5631bf5c35094514),
+    Fixed(0x0000000000000000, 0xad6a0261acf967d9, 0x4d552f811cd40845, 0x839e04578161ccf6),
+    Fixed(0x0000000000000000, 0xaf70154920b3ab86, 0xb04afe92103ef4c6, 0x29f04ae4e7a29308),
+}};
+
+/**
+ * @brief sin(j / 64), j = 0..50.
+ */
+inline constexpr std::array<U256, 51> SIN_TABLE {{
+    Fixed(0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000),
+    Fixed(0x0000000000000000, 0x03fff5555dddda9d, 0xaa938cac1f113dca, 0x62c181f7f5624024),
+    Fixed(0x0000000000000000, 0x07ffaaabbbba1ba3, 0x2bf904ddb51e4655, 0xe5790d2ec611113c),
+    Fixed(0x0000000000000000, 0x0bfee008197dd454, 0xcc841722cd0cc475, 0x75f5ca5a34d0d55c),
+    Fixed(0x0000000000000000, 0x0ffd557776a76d5a, 0x5d259b2f692d4aca, 0xfb074dfbb9cbf2d8),
+    Fixed(0x0000000000000000, 0x13facb12d1755a9b, 0x79bab59ae5d278c9, 0x058ee45ef70faa39),
+    Fixed(0x0000000000000000, 0x17f701032550e41a, 0xfc2d1800501a1007, 0xe59085f4c393f5ab),
+    Fixed(0x0000000000000000, 0x1bf1b78568391d7a, 0x461077a9331f2958, 0x127f32744b090172),
+    Fixed(0x0000000000000000, 0x1feaaeee86ee35ca, 0x069a86721f89f85a, 0x5995027b5e671884),
+    Fixed(0x0000000000000000, 0x23e1a7af5f9d5d48, 0x8357b344b2da517a, 0x4194f3c5bf5269e1),
+    Fixed(0x0000000000000000, 0x27d66258bacd96a3, 0xeb335b365c87d594, 0x38c5142bb56a489f),
+    Fixed(0x0000000000000000, 0x2bc89f9f424de548, 0x5de7ce03b2514952, 0xb9faf5648c3244d4),
+    Fixed(0x0000000000000000, 0x2fb8205f75e56a2b, 0x56a1c4792f856258, 0x769af396e0189ef7),
+    Fixed(0x0000000000000000, 0x33a4a5a19d862467, 0x10f602c44df4fa51, 0x3f4639ce938477af),
+    Fixed(0x0000000000000000, 0x378df09db8c332ce, 0x0d2b53d865582e45, 0x26ea336c768f68c3),
+    Fixed(0x0000000000000000, 0x3b73c2bf6b4b9f66, 0x8ef9499c81f0d965, 0x087f1753fa64b087),
+    Fixed(0x0000000000000000, 0x3f55dda9e62aed75, 0x13bd7b8e6a3d1635, 0xdd5676648d7db526),
+    Fixed(0x0000000000000000, 0x4334033bcd90d660, 0x4f5f36c1d4b84451, 0xa87150438275b774),
+    Fixed(0x0000000000000000, 0x470df5931ae1d946, 0x076fe0dcff47fe31, 0xbb2ede618ebc6078),
+    Fixed(0x0000000000000000, 0x4ae37710fad27c8a, 0xa9c4cf96c03519b9, 0xce07dc08a1471775),
+    Fixed(0x0000000000000000, 0x4eb44a5da74f6002, 0x07aaa090f0734e28, 0x8603ffadb3eb2543),
+    Fixed(0x0000000000000000, 0x5280326c3cf48182, 0x3ba6bb08eac82c20, 0x93f2bce3c4eb4ee4),
+    Fixed(0x0000000000000000, 0x5646f27e8bd65cbe, 0x3a5d61ff06572290, 0xee826d9674a00247),
+    Fixed(0x0000000000000000, 0x5a084e28e35fda27, 0x76dfdbbb5531d74c, 0xed2b5d17c0b1afc4),
+    Fixed(0x0000000000000000, 0x5dc40955d9084f48, 0xa94675a2498de5d8, 0x51320ff5528a6afb),
+    Fixed(0x0000000000000000, 0x6179e84a09a5258a, 0x40e9b5face03e525, 0xf8b5753cd0105d94),
+    Fixed(0x0000000000000000, 0x6529afa7d51b1296, 0x31ec197c0a840a11, 0xd7dc5368b0a47957),
+    Fixed(0x0000000000000000, 0x68d3247314332797, 0x3bc712bcc4ccddc4, 0x7630d755850c0655),
+    Fixed(0x0000000000000000, 0x6c760c14c8585a51, 0xdbd34660ae6c52ac, 0x7036a0b40887a0b6),
+    Fixed(0x0000000000000000, 0x70122c5ec5028c8c, 0xff33abf4fd340ccc, 0x382e038379b09cf0),
+    Fixed(0x0000000000000000, 0x73a74b8f52947b68, 0x1baf6928eb3fb021, 0x769bf4779bad0e3b),
+    Fixed(0x0000000000000000, 0x77353054ca72690d, 0x4c6e171fd99e6b39, 0xfa8e1ede5f052fd3),
+    Fixed(0x0000000000000000, 0x7abba1d12c17bfa1, 0xd92f0d93f60ded99, 0x92f45b4fcaf13cd6),
+    Fixed(0x0000000000000000, 0x7e3a679daaf25c67, 0x6542bcb4028d0964, 0x172961c921823a4f),
+    Fixed(0x0000000000000000, 0x81b149ce34caa5a4, 0xe650f8d09fd4d6aa, 0x74206c32ca951a93),
+    Fixed(0x0000000000000000, 0x852010f4f0800521, 0x378bd8dd614753d0, 0x80c2e9e0775ffc61),
+    Fixed(0x0000000000000000, 0x88868625b4e1dbb2, 0x3133101330225272, 0x00c143a5cb16637d),
+    Fixed(0x0000000000000000, 0x8be472f9776d809a, 0xf2b88171243d63d6, 0x6dfceeeb739cc895),
+    Fixed(0x0000000000000000, 0x8f39a191b2ba6122, 0xa3fa4f41d5a3ffd4, 0x21417d46f19a2223),
+    Fixed(0x0000000000000000, 0x9285dc9bc45dd9ea, 0x3d02457bcce59c41, 0x75aab6ff7929a8d3),
+    Fixed(0x0000000000000000, 0x95c8ef544210ec0b, 0x91c49bd2aa09e851, 0x5fa61a156ebb10f6),
+    Fixed(0x0000000000000000, 0x9902a58a45e27bed, 0x68412b426b675ed5, 0x03f54d14c8172e0d),
+    Fixed(0x0000000000000000, 0x9c32cba2b14156ef, 0x05256c4f857991ca, 0x6a547cd7ceb1ac8b),
+    Fixed(0x0000000000000000, 0x9f592e9b66a9cf90, 0x6a3c7aa3c1019984, 0x9040c45ec3f0a747),
+    Fixed(0x0000000000000000, 0xa2759c0e79c35582, 0x527c32b55f5405c1, 0x82c66160cb1d9eb8),
+    Fixed(0x0000000000000000, 0xa587e23555bb0808, 0x6d02b9c662cdd293, 0x16c3e9bd08d93793),
+    Fixed(0x0000000000000000, 0xa88fcfebd9a8dd47, 0xe2f3c76ef9e24399, 0x20f7e7fbe735f8bd),
+    Fixed(0x0000000000000000, 0xab8d34b36acd9872, 0x10ed343ec65d7e3a, 0xdc2e7109fce43d56),
+    Fixed(0x0000000000000000, 0xae7fe0b5fc786b2d, 0x966e1d6af140a488, 0x476747c2646425fc),
+    Fixed(0x0000000000000000, 0xb167a4c90d63c424, 0x4cf5493b7cc23bd3, 0xc3c1225e078baa0c),
+    Fixed(0x0000000000000000, 0xb44452709a597529, 0x05913765434a59d1, 0x11f0433eb2b133f8),
+}};
+
+/**
+ * @brief cos(j / 64), j = 0..50.
+ */
+inline constexpr std::array<U256, 51> COS_TABLE {{
+    Fixed(0x0000000000000001, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000),
+    Fixed(0x0000000000000000, 0xfff8000aaaa4fa51, 0x4514074bde6ace45, 0x104dd21b8d241e94),
+    Fixed(0x0000000000000000, 0xffe000aaa93e9589, 0x576da4ec94946fb9, 0x419c52ed4a661fc5),
+    Fixed(0x0000000000000000, 0xffb8035fefccf674, 0xc4a9f9b72a141836, 0x299a949cee13e78a),
+    Fixed(0x0000000000000000, 0xff800aaa4fa69a65, 0x070f73284de215b8, 0xf80466e85a2928be),
+    Fixed(0x0000000000000000, 0xff381a094f7b771a, 0x05e641b4834be062, 0xb9df9716ae6d2f79),
+    Fixed(0x0000000000000000, 0xfee035fbf35cda63, 0x2056a6bf1b6b28df, 0xc3813d8eb961faae),
+    Fixed(0x0000000000000000, 0xfe78640074cd88f5, 0x1ebc368c35611b2a, 0xd38361e93aa13761),
+    Fixed(0x0000000000000000, 0xfe00aa93eade9b6d, 0x1e6a129df6f18ce5, 0x649bab98783f8311),
+    Fixed(0x0000000000000000, 0xfd791131e25e97ab, 0x54c7b317625d2cc1, 0x578c42df76b5a002),
+    Fixed(0x0000000000000000, 0xfce1a053e621438b, 0x6d60c76e8c45bf0a, 0x9dc71aa16f922acc),
+    Fixed(0x0000000000000000, 0xfc3a6170f767ac73, 0x5d63d99a9d439e1d, 0xb5e59d3ef153a426),
+    Fixed(0x0000000000000000, 0xfb835efcf670dd2c, 0xe6fe7924697eea13, 0xea358867e9cdb38a),
+    Fixed(0x0000000000000000, 0xfabca467fb3cb8f1, 0xd069f01d8ea33ade, 0x5bfd68296ecd1cca),
+    Fixed(0x0000000000000000, 0xf9e63e1d9e8b6f6f, 0x2e296bae5b5ed9c1, 0x1fd7fa2fe11e09fc),
+    Fixed(0x0000000000000000, 0xf90039843324f9b9, 0x40416c1984b6cbed, 0x1fc733d97354d426),
+    Fixed(0x0000000000000000, 0xf80aa4fbef750ba7, 0x83d33cb95f94f8a4, 0x1426dbe79edc4a02),
+    Fixed(0x0000000000000000, 0xf7058fde0788dfc8, 0x05b8fe88789e4f42, 0x53e3c50afe8b22f4),
+    Fixed(0x0000000000000000, 0xf5f10a7bb77d3dfa, 0x0c1da8b578427832, 0x80d01ce3c0f82bae),
+    Fixed(0x0000000000000000, 0xf4cd261d3e6c15bb, 0x369c8758630d2ac0, 0x0b7ace2a51c0631c),
+    Fixed(0x0000000000000000, 0xf399f500c9e9fd37, 0xae9957263dab8877, 0x102beb569f101ee4),
+    Fixed(0x0000000000000000, 0xf2578a595224dd2e, 0x6bfa2eb2f99cc674, 0xf5ea6f479eae2eb6),
+    Fixed(0x0000000000000000, 0xf105fa4d66b607a6, 0x7d44e04272520443, 0x5142ac8ad54dfb09),
+    Fixed(0x0000000000000000, 0xefa559f5ec3aec3a, 0x4eb03319278a2d41, 0xfcf9189462261126),
+    Fixed(0x0000000000000000, 0xee35bf5ccac89052, 0xcd91ddb734d3a47e, 0x262e3b609db604e2),
+    Fixed(0x0000000000000000, 0xecb7417b8d4ee3fe, 0xc37aba4073aa48f1, 0xf14666006fb431d9),
+    Fixed(0x0000000000000000, 0xeb29f839f201fd13, 0xb93796827916a78f, 0x15c85230a4e8ea4b),
+    Fixed(0x0000000000000000, 0xe98dfc6c6be031e6, 0x0dd3089cbdd18a75, 0xb1f6b2c1e97f7922),
+    Fixed(0x0000000000000000, 0xe7e367d2956cfb16, 0xb6aa11e5419cd005, 0x7f5c132a6455bf06),
+    Fixed(0x0000000000000000, 0xe62a551594b970a7, 0x70b15d41d4c0e483, 0xe47aca550111df69),
+    Fixed(0x0000000000000000, 0xe462dfc670d421ab, 0x3d1a15901228f146, 0xa0547011202bf5ab),
+    Fixed(0x0000000000000000, 0xe28d245c58baef72, 0x225e232abc003c43, 0x66acd9eb4fc2808c),
+    Fixed(0x0000000000000000, 0xe0a94032dbea7ced, 0xbddd9da2fafad985, 0x56566b3a89f43eac),
+    Fixed(0x0000000000000000, 0xdeb7518814a7a931, 0xbbcc88c109cd41c5, 0x0bf8bb48f20ae8c3),
+    Fixed(0x0000000000000000, 0xdcb7777ac4207051, 0x68f31e3eb780ce9c, 0x939ecada62843b54),
+    Fixed(0x0000000000000000, 0xdaa9d20860827063, 0xfde51c09e855e993, 0x2e1b17143e7244fd),
+    Fixed(0x0000000000000000, 0xd88e820b1526311d, 0xd561efbc0c1a9a53, 0x75eb26f65d246c57),
+    Fixed(0x0000000000000000, 0xd665a937b4ef2b1f, 0x6d51bad6d988a441, 0x9c1d7051faf31a9f),
+    Fixed(0x0000000000000000, 0xd42f6a1b9f0168cd, 0xf031c2f63c8d9304, 0xd86f8d34cb1d5fcd),
+    Fixed(0x0000000000000000, 0xd1ebe81a95ee752e, 0x48a26bcd32d6e922, 0xd7eb44b8ad2232f7),
+    Fixed(0x0000000000000000, 0xcf9b476c897c25c5, 0xbfe750dd3f308eaf, 0x7bcc1ed00179a257),
+    Fixed(0x0000000000000000, 0xcd3dad1b5328a2e4, 0x59f993f4f5108819, 0xfaccbc4eeba9604f),
+    Fixed(0x0000000000000000, 0xcad33f00658fe5e8, 0x204bbc0f3a66a0e6, 0xa773f87987a780b2),
+    Fixed(0x0000000000000000, 0xc85c23c26ed7b6f0, 0x14ef546c47929682, 0x122876bfbf157de1),
+    Fixed(0x0000000000000000, 0xc5d882d2ee48030c, 0x7c07d28e981e3480, 0x4f82ed4cf93655d2),
+    Fixed(0x0000000000000000, 0xc348846bbd363133, 0x8ffe2bfe9dd1381a, 0x35b4e9c0c51b4c14),
+    Fixed(0x0000000000000000, 0xc0ac518c8b6ae710, 0xba37a3eeb90cb15a, 0xebcb8bed4356fb50),
+    Fixed(0x0000000000000000, 0xbe0413f84f2a771c, 0x614946a88cbf4da1, 0xd75a5560243de8f2),
+    Fixed(0x0000000000000000, 0xbb4ff632a908f73e, 0xc151839cb9d993b4, 0xe0bfb8f20e7e44e7),
+    Fixed(0x0000000000000000, 0xb890237d3bb3c284, 0xb614a0539016bfa1, 0x053730bbdf940fa9),
+    Fixed(0x0000000000000000, 0xb5c4c7d4f7dae915, 0xac786ccf4b1a498d, 0x3e73b6e5e74fe752),
+}};
+
+/**
+ * @brief atan(j / 64), j = 0..64.
+ */
+inline constexpr std::array<U256, 65> ATAN_TABLE {{
+    Fixed(0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000),
+    Fixed(0x0000000000000000, 0x03ffeaab776e5356, 0xef9e31590057dd81, 0x2083bd970437bbd2),
+    Fixed(0x0000000000000000, 0x07ff556eea5d892a, 0x13bcebbb6ed46310, 0x9c036814a606dc41),
+    Fixed(0x0000000000000000, 0x0bfdc0c2186d14fc, 0xf220e10d61df56ec, 0x71dddd64f807f209),
+    Fixed(0x0000000000000000, 0x0ffaaddb967ef4e3, 0x6cb2792dc0e2e0d5, 0x1319c12cf59d4b2e),
+    Fixed(0x0000000000000000, 0x13f59f0e7c559d6b, 0x1338a177e11cd9be, 0xc9eb30fb4bf3790d),
+    Fixed(0x0000000000000000, 0x17ee182602f10e8c, 0x126acfcf099f06ce, 0xcfc1508f3055c1b8),
+    Fixed(0x0000000000000000, 0x1be39ebe6f07c37d, 0xee3ca681661cbb3d, 0xd21afca1d234427e),
+    Fixed(0x0000000000000000, 0x1fd5ba9aac2f6dc6, 0x5912f313e7d111de, 0xf1672afb2bb35b24),
+    Fixed(0x0000000000000000, 0x23c3f5f6086e4dc9, 0x6f4dd64a60e82be6, 0x78a856b0a7f00324),
+    Fixed(0x0000000000000000, 0x27adddd18cc4d8b0, 0xd1d8674940d83fa1, 0x5dd4bd3e2eb74a37),
+    Fixed(0x0000000000000000, 0x2b93023c7d84d3be, 0xad534ffbc30b7a65, 0x0b4f9b7546c1ad33),
+    Fixed(0x0000000000000000, 0x2f72f6979cb6044d, 0x1ec2d3e207271d21, 0xe4eb4035a0e28acb),
+    Fixed(0x0000000000000000, 0x334d51d2d90c4c39, 0xec03cf68691bbace, 0xaafc499306f09d87),
+    Fixed(0x0000000000000000, 0x3721aea524c14408, 0xbd88697072d54bc0, 0xa19144a34e92c495),
+    Fixed(0x0000000000000000, 0x3aefabbe40ae6ce3, 0x2468a9a2cbef5e39, 0xec4b3b0a80cbfc01),
+    Fixed(0x0000000000000000, 0x3eb6ebf25901bac5, 0x5b71e7bd7de885f9, 0x6a9fea40e22ce0db),
+    Fixed(0x0000000000000000, 0x4277165f618d8962, 0xe47390cb8655e9d1, 0x571285505b7e82d8),
+    Fixed(0x0000000000000000, 0x462fd68c2fc5e098, 0x6523a458dfc414c6, 0x87e9714de0d27de8),
+    Fixed(0x0000000000000000, 0x49e0dc815fbd16f8, 0x8322c92037f0a23d, 0x223e10cf906b1916),
+    Fixed(0x0000000000000000, 0x4d89dcdc1faf2f34, 0xe2d5da4c693d7994, 0x045247c28597ab00),
+    Fixed(0x0000000000000000, 0x512a90db0abc26a2, 0xa1bc3aa4c45c6cf1, 0xa7413c521a2ec306),
+    Fixed(0x0000000000000000, 0x54c2b6654735276d, 0x4cdbfbbdfbecf460, 0x90961ce98f7a6bea),
+    Fixed(0x0000000000000000, 0x5852100c273f8658, 0xda8ea8ee100507e1, 0x5a042e6f4bd6b6b8),
+    Fixed(0x0000000000000000, 0x5bd86507937bc239, 0xc55190916e7f2241, 0x9ec21cbbd72a2ae6),
+    Fixed(0x0000000000000000, 0x5f55812d8ecfdd69, 0xc885c2b249a08813, 0x12e09e0eaf2efba0),
+    Fixed(0x0000000000000000, 0x62c934e5286c95b6, 0xd0ba3748fa85146e, 0xe25be4f2869d50fb),
+    Fixed(0x0000000000000000, 0x6633551535ac619e, 0x6c988fd0a76cdbe1, 0xc93d002a4410cb0a),
+    Fixed(0x0000000000000000, 0x6993bb0f308ff2db, 0x213e4af4800f389b, 0x3700206e90b0d39e),
+    Fixed(0x0000000000000000, 0x6cea44769971b1ae, 0x187b1ca504031a2e, 0xaaa4088c5fdb8226),
+    Fixed(0x0000000000000000, 0x7036d3253b27be33, 0xe318f6cb3cc65c01, 0xdb0a5f97af9f5c12),
+    Fixed(0x0000000000000000, 0x73794d0cb04d425d, 0x305bbe70e536e164, 0x325927439e7941da),
+    Fixed(0x0000000000000000, 0x76b19c1586ed3da2, 0xb7f222f65e1d4681, 0xb70a0ac3930e6f80),
+    Fixed(0x0000000000000000, 0x79dfadfc5d68d10e, 0x53dc1bf34356f9fd, 0x1790505c402ec724),
+    Fixed(0x0000000000000000, 0x7d03742d50505f2e, 0x33691e3eaee47661, 0x0806496fc5c5aac2),
+    Fixed(0x0000000000000000, 0x801ce39e0d205c99, 0xa6d6c6c54d938596, 0x692486326fe2e1cc),
+    Fixed(0x0000000000000000, 0x832bf4a6d9867e2a, 0x4b6a09cb61a515c0, 0xf1155cd8774ddfbc),
+    Fixed(0x0000000000000000, 0x8630a2dada1ed065, 0xd3e84ed5013ca37d, 0x92a950da94553291),
+    Fixed(0x0000000000000000, 0x892aecdfde9547b5, 0x094478fc472b4afb, 0x8fbe7b9fb9ddf67f),
+    Fixed(0x0000000000000000, 0x8c1ad445f3e09b8c, 0x439d801860205920, 0xf8e244490311ce07),
+    Fixed(0x0000000000000000, 0x8f005d5ef7f59f9b, 0x5c835e1665c43747, 0x918a67e0652b375d),
+    Fixed(0x0000000000000000, 0x91db8f1664f350e2, 0x10e4f9c1126e021f, 0xd995e8d1fc353437),
+    Fixed(0x0000000000000000, 0x94ac72c9847186f6, 0x18c4f393f78a32f8, 0xf38ae0f47a945eda),
+    Fixed(0x0000000000000000, 0x97731420365e538b, 0xabd3fe19f1aeb6b2, 0x9798db274070578e),
+    Fixed(0x0000000000000000, 0x9a2f80e671bdda20, 0x4226f8e2204ff3bc, 0xdae46f0617489d5c),
+    Fixed(0x0000000000000000, 0x9ce1c8e6a0b8cdb9, 0xf799c4e8174cf11c, 0x5a2ac6a3b26e793f),
+    Fixed(0x0000000000000000, 0x9f89fdc4f4b7a1ec, 0xf8b492644f0701df, 0x9d743d1bc801acaa),
+    Fixed(0x0000000000000000, 0xa22832dbcadaae08, 0x92fe9c08637af0e5, 0xd084146d4fd55be4),
+    Fixed(0x0000000000000000, 0xa4bc7d1934f70924, 0x19a87f2a457dac9e, 0xe3f08689eeb2b9e7),
+    Fixed(0x0000000000000000, 0xa746f2ddb7602294, 0x67b7d66f2d74e019, 0x21b81774d87a36a5),
+    Fixed(0x0000000000000000, 0xa9c7abdc4830f5c8, 0x916a84b5be7933f5, 0xf9971655e427bf1c),
+    Fixed(0x0000000000000000, 0xac3ec0fb997dd6a1, 0xa36273a56afa8ef4, 0x183db5406c42068d),
+    Fixed(0x0000000000000000, 0xaeac4c38b4d8c080, 0x14725e2f3e52070a, 0x03742b4643effe26),
+    Fixed(0x0000000000000000, 0xb110688aebdc6f6a, 0x43d65788b9f6a7b5, 0x09e2828d4df9e1c7),
+    Fixed(0x0000000000000000, 0xb36b31c91f043691, 0x590141744462f939, 0xe469ff280783f6fe),
+    Fixed(0x0000000000000000, 0xb5bcc49059ecc4af, 0xf8f3cee75e3907d5, 0x75216f47b3891e08),
+    Fixed(0x0000000000000000, 0xb8053e2bc2319e73, 0xcb2da55210a4443d, 0x3d7aecc114c79a81),
+    Fixed(0x0000000000000000, 0xba44bc7dd470782f, 0x654c2cb10942e386, 0x23228454d454a343),
+    Fixed(0x0000000000000000, 0xbc7b5deae98af280, 0xd4113006e80fb290, 0x13fab81f5ba4ab8a),
+    Fixed(0x0000000000000000, 0xbea94144fd049aac, 0x1043c5e755282e7d, 0x01438341f13d5c3a),
+    Fixed(0x0000000000000000, 0xc0ce85b8ac526640, 0x89dd62c46e92fa24, 0xd58ee867aef436f6),
+    Fixed(0x0000000000000000, 0xc2eb4abb661628b5, 0xb373fe45c61bb9fa, 0xe970ec0e0e4baa67),
+    Fixed(0x0000000000000000, 0xc4ffaffabf8fbd54, 0x8cb43d10bc9e0221, 0x4da621b60039834f),
+    Fixed(0x0000000000000000, 0xc70bd54ce602ee13, 0xe7d54fbd09f2be38, 0x0e9c986eaf9b702b),
+    Fixed(0x0000000000000000, 0xc90fdaa22168c234, 0xc4c6628b80dc1cd1, 0x29024e088a67cc74),
+}};
+
+/**
+ * @brief Произведение чисел в фиксированной точке: биты [192, 448) 512-битного произведения.
+ * Считается столбцами по 64 бита; три младших частичных произведения (столбцы 0 и 1) пропускаются,
+ * что занижает результат не более чем на единицу младшего разряда. Результат должен быть меньше 2^64.
+ */
+inline U256 Mul(const U256& a, const U256& b) {
+    const u64 x[4] = {a.low().low(), a.low().high(), a.high().low(), a.high().high()};
+    const u64 y[4] = {b.low().low(), b.low().high(), b.high().low(), b.high().high()};
+    u64 low = 0, high = 0, carry = 0; // Текущий столбец и переносы из него.
+    const auto add = [&](int i, int j) {
+        const U128 product = U128::mult_ext(x[i], y[j]);
+        low += product.low();
+        const u64 c = low < product.low() ? 1 : 0;
+        high += product.high();
+        carry += high < product.high() ? 1 : 0;
+        high += c;
+        carry += high < c ? 1 : 0;
+    };
+    const auto next = [&] {
+        const u64 word = low;
+        low = high;
+        high = carry;
+        carry = 0;
+        return word;
+    };
+    // Старшие слова чисел меньше единицы нулевые: их произведения пропускаются.
+    const bool x3 = x[3] != 0;
+    const bool y3 = y[3] != 0;
+    add(0, 2); add(1, 1); add(2, 0);
+    next();
+    add(1, 2); add(2, 1);
+    if (y3) add(0, 3);
+    if (x3) add(3, 0);
+    const u64 w0 = next();
+    add(2, 2);
+    if (y3) add(1, 3);
+    if (x3) add(3, 1);
+    const u64 w1 = next();
+    if (y3) add(2, 3);
+    if (x3) add(3, 2);
+    const u64 w2 = next();
+    if (x3 && y3) add(3, 3);
+    const u64 w3 = next();
+    return U256{U128{w0, w1}, U128{w2, w3}};
+}
+
+/**
+ * @brief Обратное число 1 / z для z из [1, 2]: начальное приближение в long double
+ * и два шага Ньютона y = y * (2 - z * y), каждый из которых удваивает число верных бит.
+ */
+inline U256 Reciprocal(const U256& z) {
+    const long double estimate = 0x1p64L / u128::utils::to_long_double((z >> (FRACTION_BITS - 64)).low());
+    U256 y = U256{static_cast<u64>(estimate * 0x1p63L)} << (FRACTION_BITS - 63);
+    for (int i = 0; i < 2; ++i)
+        y = Mul(y, (ONE << 1) - Mul(z, y));
+    return y;
+}
+
+/**
+ * @brief Модуль числа в масштабе 10^MaxWidth(): |x| * 10^12 (меньше 2^168).
+ */
+inline U256 Scaled(const Decimal& x) {
+    return U256::mult_ext(x.IntegerPart().unsigned_part(), bignum::u128::pow10(Decimal::MaxWidth())) + U256{x.FractionAtMaxWidth()};
+}
+
+/**
+ * @brief Перевод Scaled-значения, меньшего 2^64, в фиксированную точку.
+ */
+inline U256 ToFixed(const U256& scaled) {
+    return (scaled << FRACTION_BITS).divrem(MAX_DENOMINATOR).first;
+}
+
+/**
+ * @brief Decimal из модулей целой и дробной (в текущей ширине) частей и знака.
+ */
+inline Decimal MakeDecimal(const U128& integer, const U128& fraction, bool negative) {
+    const Integer integer_part{integer};
+    const Integer fraction_part{fraction};
+    Decimal result;
+    if (!negative)
+        result.SetDecimal(integer_part, fraction_part);
+    else if (!integer_part.is_zero())
+        result.SetDecimal(-integer_part, fraction_part);
+    else // Если целая часть равна нулю, то знак храним в числителе.
+        result.SetDecimal(integer_part, -fraction_part);
+    return result;
+}
+
+/**
+ * @brief Значение mantissa * 2^-shift, разложенное для округления до ширины текущего контекста.
+ */
+struct Digits {
+    U256 integer;                  // Целая часть.
+    U128 fraction;                 // Цифры дробной части, отбрасыванием.
+    rounding::Remainder remainder; // Класс отброшенного остатка.
+};
+
+/**
+ * @brief Разложение value * 2^-shift на целую часть, цифры дробной части и класс остатка.
+ * Остаток сжимается до 126 бит, а вытесненные биты собираются в младший (sticky): класс от этого не меняется.
+ */
+inline Digits SplitDigits(const U256& value, uint32_t shift) {
+    const U256 integer = value >> shift;
+    U256 fraction = value - (integer << shift);
+    bool sticky = false;
+    if (shift > 200) { // Дробная часть умножается на 10^width < 2^40 без переполнения.
+        sticky = fraction != ((fraction >> (shift - 200)) << (shift - 200));
+        fraction >>= shift - 200;
+        shift = 200;
+    }
+    const U256 scaled = fraction * U256{Decimal::Denominator().unsigned_part()};
+    const U256 digits = scaled >> shift;
+    const U256 rest = scaled - (digits << shift);
+    constexpr uint32_t GUARD_BITS = 126;
+    U128 guard;
+    if (shift > GUARD_BITS) {
+        guard = (rest >> (shift - GUARD_BITS)).low();
+        sticky |= rest != (U256{guard} << (shift - GUARD_BITS));
+    } else {
+        guard = (rest << (GUARD_BITS - shift)).low();
+    }
+    guard |= U128{sticky ? 1u : 0u};
+    return {integer, digits.low(), rounding::Classify(guard, U128{1} << GUARD_BITS)};
+}
+
+/**
+ * @brief Округление значения mantissa * 2^-shift до ширины и по режиму текущего контекста,
+ * как в operator* и Sqrt.
+ * @param error Оценка погрешности mantissa сверху: истинное значение лежит в [mantissa - error, mantissa + error].
+ * Если концы отрезка округляются одинаково, результат округлен верно. Иначе на отрезке лежит граница
+ * округления - цифра младшего разряда или ее половина, - и значение считается равным ей: так точно
+ * представимые результаты (1, 2,25, 1024) и точные половины (1,5^2 при ширине 1) округляются верно,
+ * а неточное значение ближе 2^-180 к границе практически невозможно.
+ * Результат с модулем не больше error считается точным нулем.
+ */
+inline Decimal ToDecimal(const U256& mantissa, uint32_t shift, bool negative, const U256& error) {
+    if (mantissa <= error)
+        return MakeDecimal(U128{0}, U128{0}, false);
+    const Digits low = SplitDigits(mantissa - error, shift);
+    const Digits high = SplitDigits(mantissa + error, shift);
+    Decimal result;
+    if (high.integer.high() != 0) {
+        result.SetInfinity();
+        return result;
+    }
+    const bool same_digits = low.integer == high.integer && low.fraction == high.fraction;
+    const rounding::Remainder remainder = !same_digits || low.remainder == rounding::EXACT ? rounding::EXACT
+                                          : low.remainder != high.remainder               ? rounding::HALF
+                                                                                          : high.remainder;
+    U256 integer = high.integer;
+    U128 fraction = high.fraction;
+    const bool has_fraction = Decimal::GetWidth() > 0;
+    const bool odd = ((has_fraction ? fraction : integer.low()).low() & 1) != 0;
+    if (rounding::Increment(Decimal::GetRounding(), remainder, negative, odd)) {
+        if (has_fraction) // Дробная часть, равная знаменателю, переносится в целую в Normalize.
+            fraction += U128{1};
+        else
+            integer += U256{1};
+        if (integer.high() != 0) {
+            result.SetInfinity();
+            return result;
+        }
+    }
+    return MakeDecimal(integer.low(), fraction, negative);
+}
+
+/**
+ * @brief Ненулевой результат с модулем меньше половины младшего разряда при любой ширине (exp(z) при z <= -30):
+ * ноль или, если этого требует режим округления, одна единица младшего разряда.
+ */
+inline Decimal Underflow(bool negative) {
+    if (!rounding::Increment(Decimal::GetRounding(), rounding::BELOW_HALF, negative, false))
+        return MakeDecimal(U128{0}, U128{0}, false);
+    return Decimal::GetWidth() > 0 ? MakeDecimal(U128{0}, U128{1}, negative) : MakeDecimal(U128{1}, U128{0}, negative);
+}
+
+/**
+ * @brief exp(t) для t из [0, 1/64): ряд Тейлора до t^22 / 22! по схеме Горнера.
+ */
+inline U256 ExpSeries(const U256& t) {
+    U256 p = INV_FACTORIALS[22];
+    for (int n = 21; n >= 0; --n)
+        p = INV_FACTORIALS[n] + Mul(p, t);
+    return p;
+}
+
+/**
+ * @brief ln(1 + t) для t из [0, 1/64]: знакопеременный ряд до t^32 / 32.
+ */
+inline U256 LnSeries(const U256& t) {
+    U256 q = INVERSES[32];
+    for (int n = 31; n >= 1; --n)
+        q = INVERSES[n] - Mul(t, q);
+    return Mul(t, q);
+}
+
+/**
+ * @brief sin(t) и cos(t) для t из [0, 1/64): ряды до t^23 / 23! и t^22 / 22!.
+ */
+inline void SinCosSeries(const U256& t, U256& sin_t, U256& cos_t) {
+    const U256 u = Mul(t, t);
+    U256 s = INV_FACTORIALS[23];
+    U256 c = INV_FACTORIALS[22];
+    for (int k = 10; k >= 0; --k) {
+        s = INV_FACTORIALS[2 * k + 1] - Mul(u, s);
+        c = INV_FACTORIALS[2 * k] - Mul(u, c);
+    }
+    sin_t = Mul(t, s);
+    cos_t = c;
+}
+
+/**
+ * @brief atan(t) для |t| <= 1/128: знакопеременный ряд до t^29 / 29.
+ */
+inline U256 AtanSeries(const U256& t) {
+    const U256 u = Mul(t, t);
+    U256 a = INVERSES[29];
+    for (int m = 27; m >= 1; m -= 2)
+        a = INVERSES[m] - Mul(u, a);
+    return Mul(t, a);
+}
+
+/**
+ * @brief exp(z) для z из (-30, 89) в фиксированной точке (знак отдельно).
+ * Сведение: z = k * ln(2) + j / 64 + t, где r = z - k * ln(2) из [0, ln(2)), j = floor(64 r), t из [0, 1/64);
+ * exp(z) = 2^k * EXP_TABLE[j] * exp(t).
+ * @param shift Результат равен mantissa * 2^-shift.
+ */
+inline U256 ExpFixed(const U256& z, bool negative, uint32_t& shift) {
+    u64 q = (Mul(z, INV_LN2) >> FRACTION_BITS).low().low();
+    U256 multiple = LN2 * U256{q};
+    while (multiple > z) { // Поправка на отброшенные биты INV_LN2.
+        --q;
+        multiple -= LN2;
+    }
+    U256 r = z - multiple;
+    while (r >= LN2) {
+        r -= LN2;
+        ++q;
+    }
+    int k = static_cast<int>(q);
+    if (negative) { // exp(-z) = 2^-(q + 1) * exp(ln(2) - r).
+        if (r != U256{0}) {
+            r = LN2 - r;
+            ++k;
+        }
+        k = -k;
+    }
+    const u64 j = (r >> (FRACTION_BITS - 6)).low().low();
+    const U256 t = r - (U256{j} << (FRACTION_BITS - 6));
+    shift = static_cast<uint32_t>(static_cast<int>(FRACTION_BITS) - k);
+    return Mul(EXP_TABLE[j], ExpSeries(t));
+}
+
+/**
+ * @brief ln(x) для x > 0 в фиксированной точке (знак в negative).
+ * Сведение: |x| * 10^12 = X = 2^e * m, m из [1, 2); m * LN_RECIPROCALS[j] = 1 + t, t из [0, 1/64];
+ * ln(x) = e * ln(2) + LN_TABLE[j] + ln(1 + t) - 12 * ln(10).
+ */
+inline U256 LnFixed(const Decimal& x, bool& negative) {
+    const U256 scaled = Scaled(x);
+    const uint32_t e = scaled.bit_width() - 1;
+    const U256 m = scaled << (FRACTION_BITS - e);
+    const u64 j = (m >> (FRACTION_BITS - 6)).low().low() - 64;
+    const U256 t = Mul(m, LN_RECIPROCALS[j]) - ONE;
+    const U256 positive = LN2 * U256{e} + LN_TABLE[j] + LnSeries(t);
+    const U256 negative_part = LN10 * U256{static_cast<u64>(Decimal::MaxWidth())};
+    negative = positive < negative_part;
+    return negative ? negative_part - positive : positive - negative_part;
+}
+
+/**
+ * @brief Сведение |x| к r = |x| - n * pi/2, |r| <= pi/4.
+ * Номер четверти оценивается по целой части через 2/pi с 128 битами, затем уточняется.
+ * pi/2 округлено вниз, поэтому n * PI_2 не превосходит |x| и вычитание выполняется по модулю 2^256.
+ * @param quadrant n mod 4.
+ * @param error Погрешность r: n единиц младшего разряда от округления pi/2.
+ */
+inline U256 ReduceQuarterPi(const Decimal& x, bool& r_negative, unsigned& quadrant, U256& error) {
+    const U128 integer = x.IntegerPart().unsigned_part();
+    const U256 fraction = ToFixed(U256{x.FractionAtMaxWidth()});
+    U128 n = (U256::mult_ext(integer, TWO_OVER_PI_128) >> 128).low();
+    const U256 product = U256::mult_ext(n, PI_2.low()) + (U256::mult_ext(n, PI_2.high()) << 128);
+    U256 r = (U256{integer} << FRACTION_BITS) + fraction - product;
+    while (r >= PI_2) {
+        r -= PI_2;
+        n += U128{1};
+    }
+    r_negative = r > (PI_2 >> 1);
+    if (r_negative) {
+        r = PI_2 - r;
+        n += U128{1};
+    }
+    quadrant = static_cast<unsigned>(n.low() & 3);
+    error = (U256{1} << 10) + U256{n};
+    return r;
+}
+
+/**
+ * @brief sin(r) и cos(r) для r из [0, pi/4]: r = j / 64 + t, формулы сложения с SIN_TABLE, COS_TABLE.
+ */
+inline void SinCosFixed(const U256& r, U256& sin_r, U256& cos_r) {
+    const u64 j = (r >> (FRACTION_BITS - 6)).low().low();
+    const U256 t = r - (U256{j} << (FRACTION_BITS - 6));
+    U256 sin_t, cos_t;
+    SinCosSeries(t, sin_t, cos_t);
+    sin_r = Mul(SIN_TABLE[j], cos_t) + Mul(COS_TABLE[j], sin_t);
+    cos_r = Mul(COS_TABLE[j], cos_t) - Mul(SIN_TABLE[j], sin_t);
+}
+
+/**
+ * @brief Погрешность вычислений по умолчанию, в единицах 2^-192 мантиссы.
+ */
+inline constexpr U256 DEFAULT_ERROR = U256{1} << 10;
+
+}
+
+/**
+ * @brief Экспонента. Результат округляется до ширины и по режиму текущего контекста (см. math::ToDecimal);
+ * при целой части больше 128 бит - переполнение.
+ */
+inline Decimal Exp(const Decimal& x) {
+    using namespace math;
+    Decimal result;
+    if (x.IsNotANumber() || x.IsOverflowed())
+        return x;
+    const bool negative = x.IsNegative();
+    const U128 integer = x.IntegerPart().unsigned_part();
+    if (!negative && integer >= U128{89}) { // exp(89) > 2^128.
+        result.SetInfinity();
+        return result;
+    }
+    if (negative && integer >= U128{30}) // exp(-30) < 10^-12.
+        return Underflow(false);
+    uint32_t shift;
+    const U256 mantissa = ExpFixed(ToFixed(Scaled(x)), negative, shift);
+    return ToDecimal(mantissa, shift, false, DEFAULT_ERROR);
+}
+
+/**
+ * @brief Натуральный логарифм. Для отрицательных чисел - NaN, для нуля - переполнение.
+ */
+inline Decimal Ln(const Decimal& x) {
+    using namespace math;
+    Decimal result;
+    if (x.IsNotANumber() || x.IsOverflowed())
+        return x;
+    if (x.IsZero()) {
+        result.SetInfinity();
+        return result;
+    }
+    if (x.IsNegative()) {
+        result.SetNotANumber();
+        return result;
+    }
+    bool negative;
+    const U256 magnitude = LnFixed(x, negative);
+    return ToDecimal(magnitude, FRACTION_BITS, negative, DEFAULT_ERROR);
+}
+
+/**
+ * @brief Степень x^y = exp(y * ln|x|). Отрицательное основание допускается только при целом y
+ * (знак результата - по четности y), иначе NaN. 0^0 = 1, 0^y при y < 0 - переполнение.
+ * Погрешность показателя растет с |y|, поэтому и оценка погрешности для округления пропорциональна |y|.
+ */
+inline Decimal Pow(const Decimal& x, const Decimal& y) {
+    using namespace math;
+    Decimal result;
+    if (x.IsNotANumber() || y.IsNotANumber()) {
+        result.SetNotANumber();
+        return result;
+    }
+    if (x.IsOverflowed() || y.IsOverflowed()) {
+        result.SetInfinity();
+        return result;
+    }
+    if (y.IsZero()) {
+        result.SetDecimal(Integer{1}, Integer{0});
+        return result;
+    }
+    if (x.IsZero()) {
+        if (y.IsNegative())
+            result.SetInfinity();
+        else
+            result.SetZero();
+        return result;
+    }
+    const bool negative_base = x.IsNegative();
+    if (negative_base && !y.IsInteger()) {
+        result.SetNotANumber();
+        return result;
+    }
+    const bool negative = negative_base && (y.IntegerPart().unsigned_part().low() & 1) != 0;
+    bool log_negative;
+    const U256 logarithm = LnFixed(x, log_negative);
+    const U256 exponent = Scaled(y);
+    const bool z_negative = log_negative != y.IsNegative();
+    // Модуль y * ln|x| не меньше 2^22, если произведение не помещается в 256 бит.
+    const bool is_huge = logarithm.bit_width() + exponent.bit_width() > 255;
+    const U256 z = is_huge ? U256{0} : (logarithm * exponent).divrem(MAX_DENOMINATOR).first;
+    if (is_huge || z >= ONE * U256{z_negative ? 30u : 89u}) {
+        if (z_negative)
+            return Underflow(negative);
+        result.SetInfinity();
+        return result;
+    }
+    uint32_t shift;
+    const U256 mantissa = ExpFixed(z, z_negative, shift);
+    const U256 error = (U256{y.IntegerPart().unsigned_part()} + U256{2}) << 10;
+    return ToDecimal(mantissa, shift, negative, error);
+}
+
+/**
+ * @brief Синус. Аргумент сводится к [-pi/4, pi/4] по модулю pi/2 с 192-битной pi/2,
+ * поэтому допустимы аргументы с целой частью до 2^128.
+ */
+inline Decimal Sin(const Decimal& x) {
+    using namespace math;
+    if (x.IsNotANumber() || x.IsOverflowed())
+        return x;
+    bool r_negative;
+    unsigned quadrant;
+    U256 error;
+    const U256 r = ReduceQuarterPi(x, r_negative, quadrant, error);
+    U256 sin_r, cos_r;
+    SinCosFixed(r, sin_r, cos_r);
+    // sin(r + n * pi/2) = sin r, cos r, -sin r, -cos r.
+    const bool use_sin = (quadrant & 1) == 0;
+    const bool negative = (use_sin ? r_negative : false) != (quadrant >= 2);
+    return ToDecimal(use_sin ? sin_r : cos_r, FRACTION_BITS, negative != x.IsNegative(), error);
+}
+
+/**
+ * @brief Косинус; см. Sin.
+ */
+inline Decimal Cos(const Decimal& x) {
+    using namespace math;
+    if (x.IsNotANumber() || x.IsOverflowed())
+        return x;
+    bool r_negative;
+    unsigned quadrant;
+    U256 error;
+    const U256 r = ReduceQuarterPi(x, r_negative, quadrant, error);
+    U256 sin_r, cos_r;
+    SinCosFixed(r, sin_r, cos_r);
+    // cos(r + n * pi/2) = cos r, -sin r, -cos r, sin r.
+    const bool use_cos = (quadrant & 1) == 0;
+    const bool negative = (use_cos ? false : !r_negative) != (quadrant >= 2);
+    return ToDecimal(use_cos ? cos_r : sin_r, FRACTION_BITS, negative, error);
+}
+
+/**
+ * @brief Арктангенс. При |x| > 1 используется atan(x) = pi/2 - atan(1/x); затем t = |x| сводится
+ * к ближайшему c = j / 64: atan(t) = ATAN_TABLE[j] + atan((t - c) / (1 + t c)).
+ */
+inline Decimal Atan(const Decimal& x) {
+    using namespace math;
+    if (x.IsNotANumber() || x.IsOverflowed())
+        return x;
+    const U256 scaled = Scaled(x);
+    const U256 unit = U256{bignum::u128::pow10(Decimal::MaxWidth())};
+    const bool inverted = scaled > unit;
+    U256 t;
+    if (inverted) { // 1/|x| = 10^12 / X = 10^12 * (1/m) * 2^-e, где X = 2^e * m.
+        const uint32_t e = scaled.bit_width() - 1;
+        t = (Reciprocal(scaled << (FRACTION_BITS - e)) * unit) >> e;
+    } else {
+        t = ToFixed(scaled);
+    }
+    const u64 j = ((t + (U256{1} << (FRACTION_BITS - 7))) >> (FRACTION_BITS - 6)).low().low();
+    const U256 c = U256{j} << (FRACTION_BITS - 6);
+    const bool below = t < c;
+    const U256 delta = Mul(below ? c - t : t - c, Reciprocal(ONE + Mul(t, c)));
+    const U256 atan_delta = AtanSeries(delta);
+    U256 angle = below ? ATAN_TABLE[j] - atan_delta : ATAN_TABLE[j] + atan_delta;
+    if (inverted)
+        angle = PI_2 - angle;
+    return ToDecimal(angle, FRACTION_BITS, x.IsNegative(), DEFAULT_ERROR);
+}
+
+}
@@ -0,0 +1,298 @@
+#pragma once
+
+#include <algorithm> // std::copy, std::equal
+#include <array>     // std::array
+#include <cstddef>   // size_t
+#include <cstdint>   // uint8_t, uint32_t
+#include <map>       // std::map
+#include <optional>  // std::optional
+#include <span>      // std::span
+#include <vector>    // std::vector
+#include "decimal.h"
+
+namespace dec_n {
+
+/**
+ * @brief Двоичный формат чисел Decimal и результатов факторизации: для хранения истории,
+ * передачи между процессами и пакетных файлов. Строковое представление не используется.
+ *
+ * Запись числа (little-endian):
+ *   байт 0 - биты 0..3: ширина w (0..MAX_WIDTH), бит 4: знак минус, бит 5: отрицательный ноль,
+ *            биты 6..7: вид (0 - конечное число, 1 - NaN, 2 - inf);
+ *   для конечного числа далее байт n (0..21) и n байт модуля масштабированного значения |x| * 10^w
+ *   (до 2^128 * 10^12, то есть до 21 байта): без ведущих нулевых байтов.
+ * Число восстанавливается со своей шириной w и точно тем же значением: модуль записан без потерь,
+ * поэтому ни округление, ни коррекция всех девяток режима отбрасывания к нему не применяются.
+ *
+ * Запись множителя: байт n (1..16), n байт простого числа, байт степени.
+ *
+ * Пакет: сигнатура "DCW", версия, вид записей (Payload), ширина и режим округления контекста
+ * (для множителей - нули), количество записей (4 байта), затем записи.
+ */
+class DecimalCodec {
+public:
+    /**
+     * @brief Версия формата. Пакеты более новой версии не читаются.
+     */
+    static constexpr uint8_t VERSION = 1;
+
+    /**
+     * @brief Наибольшие размеры записей числа и множителя.
+     */
+    static constexpr size_t MAX_DECIMAL_SIZE = 23;
+    static constexpr size_t MAX_FACTOR_SIZE = 18;
+
+    /**
+     * @brief Размер заголовка пакета.
+     */
+    static constexpr size_t HEADER_SIZE = 11;
+
+    /**
+     * @brief Вид записей пакета.
+     */
+    enum Payload : uint8_t {
+        DECIMALS = 1,
+        FACTORS = 2,
+    };
+
+    /**
+     * @brief Записать число.
+     * @param out Буфер не менее MAX_DECIMAL_SIZE байт.
+     * @return Указатель за последним записанным байтом.
+     */
+    static uint8_t* Encode(const Decimal& x, uint8_t* out) noexcept {
+        const bool is_overflowed = x.IsOverflowed();
+        if (is_overflowed || x.IsNotANumber()) {
+            *out++ = is_overflowed ? KIND_INFINITY : KIND_NAN;
+            return out;
+        }
+        const int width = bignum::u128::floor_log10(x.mChangedDenominator.unsigned_part());
+        const U256 scaled = U256::mult_ext(x.mInteger.unsigned_part(), bignum::u128::pow10(width))
+                            + U256{x.mNominator.unsigned_part()};
+        *out++ = static_cast<uint8_t>(width | (x.IsNegative() ? NEGATIVE : 0) | (x.mNegativeZero ? NEGATIVE_ZERO : 0));
+        return WriteMagnitude(scaled, out);
+    }
+
+    /**
+     * @brief Прочитать число.
+     * @return Указатель за прочитанной записью или nullptr, если запись обрезана или некорректна.
+     */
+    static const uint8_t* Decode(const uint8_t* first, const uint8_t* last, Decimal& x) noexcept {
+        if (first == last)
+            return nullptr;
+        const uint8_t header = *first++;
+        switch (header & KIND_MASK) {
+        case KIND_NAN:
+            x.SetNotANumber();
+            return header == KIND_NAN ? first : nullptr;
+        case KIND_INFINITY:
+            x.SetInfinity();
+            return header == KIND_INFINITY ? first : nullptr;
+        case KIND_FINITE:
+            break;
+        default:
+            return nullptr;
+        }
+        const int width = header & WIDTH_MASK;
+        if (width > DecimalContext::MAX_WIDTH)
+            return nullptr;
+        U256 scaled;
+        first = ReadMagnitude(first, last, scaled);
+        if (first == nullptr)
+            return nullptr;
+        const auto [integer, fraction] = scaled.divrem(bignum::u128::Divider<U128>{bignum::u128::pow10(width)});
+        if (integer.high() != 0)
+            return nullptr;
+        // Компоненты задаются в контексте записанной ширины, поэтому приведения знаменателя нет.
+        // Режим не TRUNCATE: точное значение вроде 2,999 не должно переноситься коррекцией девяток в 3,000.
+        const DecimalContext context{width, RoundingMode::HALF_EVEN};
+        const DecimalContext::Scope scope{context};
+        const bool negative = (header & NEGATIVE) != 0;
+        const Integer integer_part{integer.low()};
+        const Integer fraction_part{fraction};
+        if (!negative)
+            x.SetDecimal(integer_part, fraction_part);
+        else if (!integer_part.is_zero())
+            x.SetDecimal(-integer_part, fraction_part);
+        else // Если целая часть равна нулю, то знак храним в числителе.
+            x.SetDecimal(integer_part, -fraction_part);
+        x.mNegativeZero = (header & NEGATIVE_ZERO) != 0 && x.IsZero();
+        return first;
+    }
+
+    /**
+     * @brief Записать множитель prime^power.
+     * @param out Буфер не менее MAX_FACTOR_SIZE байт.
+     * @return Указатель за последним записанным байтом.
+     */
+    static uint8_t* EncodeFactor(const U128& prime, int power, uint8_t* out) noexcept {
+        out = WriteMagnitude(U256{prime}, out);
+        *out++ = static_cast<uint8_t>(power);
+        return out;
+    }
+
+    /**
+     * @brief Прочитать множитель.
+     * @return Указатель за прочитанной записью или nullptr, если запись обрезана или некорректна.
+     */
+    static const uint8_t* DecodeFactor(const uint8_t* first, const uint8_t* last, U128& prime, int& power) noexcept {
+        U256 value;
+        first = ReadMagnitude(first, last, value);
+        if (first == nullptr || first == last || value.high() != 0)
+            return nullptr;
+        prime = value.low();
+        power = *first++;
+        return first;
+    }
+
+    /**
+     * @brief Пакет чисел вместе с контекстом, в котором они получены (например, пакет для doItBatch).
+     */
+    static std::vector<uint8_t> Pack(std::span<const Decimal> values, const DecimalContext& context) {
+        std::vector<uint8_t> data(HEADER_SIZE + values.size() * MAX_DECIMAL_SIZE);
+        uint8_t* out = WriteHeader(data.data(), DECIMALS, context.Width(), static_cast<uint8_t>(context.Rounding()), values.size());
+        for (const auto& x : values)
+            out = Encode(x, out);
+        data.resize(static_cast<size_t>(out - data.data()));
+        return data;
+    }
+
+    /**
+     * @brief Прочитать пакет чисел.
+     * @param context Контекст из заголовка пакета.
+     * @return Числа или пусто, если пакет некорректен.
+     */
+    static std::optional<std::vector<Decimal>> Unpack(std::span<const uint8_t> data, DecimalContext& context) {
+        uint8_t width;
+        uint8_t rounding;
+        size_t count;
+        const uint8_t* first = ReadHeader(data, DECIMALS, width, rounding, count);
+        if (first == nullptr || width > DecimalContext::MAX_WIDTH || rounding > static_cast<uint8_t>(RoundingMode::CEILING))
+            return std::nullopt;
+        const uint8_t* const last = data.data() + data.size();
+        std::vector<Decimal> values(count);
+        for (auto& x : values) {
+            first = Decode(first, last, x);
+            if (first == nullptr)
+                return std::nullopt;
+        }
+        if (first != last)
+            return std::nullopt;
+        context = DecimalContext{width, static_cast<RoundingMode>(rounding)};
+        return values;
+    }
+
+    /**
+     * @brief Пакет результата факторизации.
+     */
+    static std::vector<uint8_t> PackFactors(const std::map<U128, int>& factors) {
+        std::vector<uint8_t> data(HEADER_SIZE + factors.size() * MAX_FACTOR_SIZE);
+        uint8_t* out = WriteHeader(data.data(), FACTORS, 0, 0, factors.size());
+        for (const auto& [prime, power] : factors)
+            out = EncodeFactor(prime, power, out);
+        data.resize(static_cast<size_t>(out - data.data()));
+        return data;
+    }
+
+    /**
+     * @brief Прочитать пакет результата факторизации.
+     * @return Множители или пусто, если пакет некорректен.
+     */
+    static std::optional<std::map<U128, int>> UnpackFactors(std::span<const uint8_t> data) {
+        uint8_t width;
+        uint8_t rounding;
+        size_t count;
+        const uint8_t* first = ReadHeader(data, FACTORS, width, rounding, count);
+        if (first == nullptr || width != 0 || rounding != 0)
+            return std::nullopt;
+        const uint8_t* const last = data.data() + data.size();
+        std::map<U128, int> factors;
+        for (size_t i = 0; i < count; ++i) {
+            U128 prime;
+            int power;
+            first = DecodeFactor(first, last, prime, power);
+            if (first == nullptr || !factors.emplace(prime, power).second)
+                return std::nullopt;
+        }
+        if (first != last)
+            return std::nullopt;
+        return factors;
+    }
+
+private:
+    using U256 = bignum::UBig<U128>;
+
+    static constexpr uint8_t WIDTH_MASK = 0x0F;
+    static constexpr uint8_t NEGATIVE = 0x10;
+    static constexpr uint8_t NEGATIVE_ZERO = 0x20;
+    static constexpr uint8_t KIND_MASK = 0xC0;
+    static constexpr uint8_t KIND_FINITE = 0x00;
+    static constexpr uint8_t KIND_NAN = 0x40;
+    static constexpr uint8_t KIND_INFINITY = 0x80;
+
+    /**
+     * @brief Наибольшая длина модуля: 2^128 * 10^12 < 2^168.
+     */
+    static constexpr uint8_t MAX_MAGNITUDE_SIZE = 21;
+
+    static constexpr std::array<uint8_t, 3> MAGIC {'D', 'C', 'W'};
+
+    /**
+     * @brief Байт длины и значимые байты модуля, младший - первый.
+     */
+    static uint8_t* WriteMagnitude(const U256& value, uint8_t* out) noexcept {
+        const u64 words[4] = {value.low().low(), value.low().high(), value.high().low(), value.high().high()};
+        const uint32_t size = (value.bit_width() + 7) / 8;
+        *out++ = static_cast<uint8_t>(size);
+        for (uint32_t i = 0; i < size; ++i)
+            *out++ = static_cast<uint8_t>(words[i / 8] >> (8 * (i % 8)));
+        return out;
+    }
+
+    static const uint8_t* ReadMagnitude(const uint8_t* first, const uint8_t* last, U256& value) noexcept {
+        if (first == last)
+            return nullptr;
+        const uint8_t size = *first++;
+        if (size > MAX_MAGNITUDE_SIZE || last - first < size)
+            return nullptr;
+        u64 words[4] {};
+        for (uint8_t i = 0; i < size; ++i)
+            words[i / 8] |= u64{first[i]} << (8 * (i % 8));
+        value = U256{U128{words[0], words[1]}, U128{words[2], words[3]}};
+        return first + size;
+    }
+
+    static uint8_t* WriteHeader(uint8_t* out, Payload payload, int width, uint8_t rounding, size_t count) noexcept {
+        out = std::copy(MAGIC.begin(), MAGIC.end(), out);
+        *out++ = VERSION;
+        *out++ = payload;
+        *out++ = static_cast<uint8_t>(width);
+        *out++ = rounding;
+        for (int i = 0; i < 4; ++i)
+            *out++ = static_cast<uint8_t>(static_cast<uint32_t>(count) >> (8 * i));
+        return out;
+    }
+
+    /**
+     * @brief Проверить заголовок пакета.
+     * @return Указатель на первую запись или nullptr.
+     */
+    static const uint8_t* ReadHeader(std::span<const uint8_t> data, Payload payload, uint8_t& width, uint8_t& rounding, size_t& count) noexcept {
+        if (data.size() < HEADER_SIZE || !std::equal(MAGIC.begin(), MAGIC.end(), data.begin()))
+            return nullptr;
+        if (data[3] == 0 || data[3] > VERSION || data[4] != payload)
+            return nullptr;
+        width = data[5];
+        rounding = data[6];
+        uint32_t n = 0;
+        for (int i = 0; i < 4; ++i)
+            n |= uint32_t{data[7 + i]} << (8 * i);
+        count = n;
+        // Каждая запись занимает не меньше байта: защита от выделения памяти по испорченному счетчику.
+        if (count > data.size() - HEADER_SIZE)
+            return nullptr;
+        return data.data() + HEADER_SIZE;
+    }
+};
+
+}
@@ -131,13 +131,12 @@ std::optional<U128> ecm::ECMFactorizer::factorize(const U128 &n)
         unsigned B1 = level.b1;
         unsigned B2 = B1 * 50;
         auto p1 = primes(B1);
-        auto p2 = primes(B2);
 
         if (u128::Globals::LoadStop()) break;
 
         for (int i = 0; i < level.curves; ++i) {
             if (u128::Globals::LoadStop()) break;
-            auto res = try_one_curve(n, B1, B2, p1, p2);
+            auto res = try_one_curve(n, B1, B2, p1);
             if (res) return res;
         }
     }
@@ -146,7 +145,7 @@ std::optional<U128> ecm::ECMFactorizer::factorize(const U128 &n)
     return std::nullopt;
 }
 
-std::optional<U128> ecm::ECMFactorizer::try_one_curve(const U128 &n, unsigned int B1, unsigned int /*B2*/, const std::vector<unsigned int> &p1, const std::vector<unsigned int> &p2)
+std::optional<U128> ecm::ECMFactorizer::try_one_curve(const U128 &n, unsigned int B1, unsigned int B2, const std::vector<unsigned int> &p1)
 {
     // Генерация параметров кривой Вейерштрасса и начальной точки
     U128 x0 = get_random_value_ab(1, n - 1);
@@ -175,10 +174,10 @@ std::optional<U128> ecm::ECMFactorizer::try_one_curve(const U128 &n, unsigned in
     }
 
     // --- STAGE 2 ---
-    return run_stage2(Q, n, a, B1, p2);
+    return run_stage2(Q, n, a, B1, B2);
 }
 
-std::optional<U128> ecm::ECMFactorizer::run_stage2(ProjPoint Q, const U128 &n, const U128 &a, unsigned int B1, const std::vector<unsigned int> &p2)
+std::optional<U128> ecm::ECMFactorizer::run_stage2(ProjPoint Q, const U128 &n, const U128 &a, unsigned int B1, unsigned int B2)
 {
     if (Q.is_inf()) return std::nullopt;
 
@@ -190,18 +189,21 @@ std::optional<U128> ecm::ECMFactorizer::run_stage2(ProjPoint Q, const U128 &n, c
         steps.push_back(projective_add(steps.back(), Q2, a, n));
     }
 
-    // Индекс первого простого > B1
-    size_t p_idx = 0;
-    while (p_idx < p2.size() && p2[p_idx] <= B1) p_idx++;
-    if (p_idx >= p2.size()) return std::nullopt;
+    // Первое простое > B1
+    PrimeRange range{u64{B1} + 1, B2};
+    auto it = range.begin();
+    if (it == range.end()) return std::nullopt;
+    u64 prev = *it;
 
-    ProjPoint T = projective_mul(U128(p2[p_idx]), Q, a, n);
+    ProjPoint T = projective_mul(U128(prev), Q, a, n);
     U128 accum_Z = 1;
     int batch = 0;
+    const bignum::u128::Divider<U128> n_div{n};
 
-    for (; p_idx + 1 < p2.size(); ++p_idx) {
-        unsigned diff = p2[p_idx + 1] - p2[p_idx];
+    for (++it; it != range.end(); ++it) {
+        unsigned diff = static_cast<unsigned>(*it - prev);
         unsigned step_idx = (diff / 2) - 1;
+        prev = *it;
 
         if (step_idx < steps.size()) {
             T = projective_add(T, steps[step_idx], a, n);
@@ -212,7 +214,7 @@ std::optional<U128> ecm::ECMFactorizer::run_stage2(ProjPoint Q, const U128 &n, c
         // Накопление Z для редкого GCD (Batch GCD)
         using U256 = bignum::UBig<U128>;
         U256 prod = U256::mult_ext(accum_Z, T.Z);
-        accum_Z = (prod / U256{n}).second.low();
+        accum_Z = prod.divrem(n_div).second;
 
         if (++batch % 64 == 0) {
             U128 d = gcd(accum_Z, n);
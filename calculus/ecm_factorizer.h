@@ -34,14 +34,14 @@ private:
      * @brief Попытка факторизации на одной случайной кривой.
      */
     static std::optional<U128> try_one_curve(const U128& n, unsigned B1, unsigned B2,
-                                             const std::vector<unsigned>& p1,
-                                             const std::vector<unsigned>& p2);
+                                             const std::vector<unsigned>& p1);
 
     /**
      * @brief Реализация Baby-Step Giant-Step в Stage 2.
+     * Простые (B1, B2] перебираются потоково сегментированным решетом.
      */
     static std::optional<U128> run_stage2(ProjPoint Q, const U128& n, const U128& a,
-                                          unsigned B1, const std::vector<unsigned>& p2);
+                                          unsigned B1, unsigned B2);
 };
 
 }
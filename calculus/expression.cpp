@@ -0,0 +1,306 @@
+#include "expression.h"
+
+#include <array>
+#include <memory>
+#include <utility>
+
+namespace calculus {
+
+/**
+ * @brief Узел дерева выражения: константа, переменная или операция с одним-двумя операндами.
+ */
+struct Expression::Node {
+    uint8_t mOpcode;
+    uint32_t mIndex = 0;
+    dec_n::Decimal mValue;
+    std::unique_ptr<Node> mLeft;
+    std::unique_ptr<Node> mRight;
+};
+
+/**
+ * @brief Разбор текста рекурсивным спуском по грамматике из описания Expression.
+ * Числа разбираются в текущем контексте потока; переменные регистрируются в выражении.
+ */
+class Expression::Parser {
+public:
+    Parser(std::string_view text, Expression& expression) : mText{text}, mExpression{expression} {}
+
+    /**
+     * @brief Разобрать весь текст.
+     * @return Корень дерева или nullptr при ошибке (позиция ошибки - Position()).
+     */
+    std::unique_ptr<Node> Parse() {
+        auto root = ParseExpression();
+        SkipSpaces();
+        if (root && mPosition != mText.size())
+            return nullptr;
+        return root;
+    }
+
+    size_t Position() const {
+        return mPosition;
+    }
+
+private:
+    /**
+     * @brief Наибольшая вложенность скобок и унарных операций: ограничивает глубину рекурсии.
+     */
+    static constexpr int MAX_DEPTH = 256;
+
+    static constexpr std::array<std::pair<std::string_view, Ops>, 4> FUNCTIONS {{
+        {"sqrt", SQRT},
+        {"sqr", SQR},
+        {"reciproc", RECIPROC},
+        {"neg", NEG},
+    }};
+
+    static bool IsDigit(char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    static bool IsLetter(char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+    }
+
+    static std::unique_ptr<Node> MakeNode(uint8_t opcode, std::unique_ptr<Node> left, std::unique_ptr<Node> right = nullptr) {
+        auto node = std::make_unique<Node>();
+        node->mOpcode = opcode;
+        node->mLeft = std::move(left);
+        node->mRight = std::move(right);
+        return node;
+    }
+
+    void SkipSpaces() {
+        while (mPosition < mText.size() && (mText[mPosition] == ' ' || mText[mPosition] == '\t'))
+            ++mPosition;
+    }
+
+    /**
+     * @brief Пропустить пробелы и символ c, если он следующий.
+     */
+    bool Accept(char c) {
+        SkipSpaces();
+        if (mPosition < mText.size() && mText[mPosition] == c) {
+            ++mPosition;
+            return true;
+        }
+        return false;
+    }
+
+    std::unique_ptr<Node> ParseExpression() {
+        auto left = ParseTerm();
+        while (left) {
+            if (Accept('+'))
+                left = MakeBinary(ADD, std::move(left), ParseTerm());
+            else if (Accept('-'))
+                left = MakeBinary(SUB, std::move(left), ParseTerm());
+            else
+                break;
+        }
+        return left;
+    }
+
+    std::unique_ptr<Node> ParseTerm() {
+        auto left = ParseUnary();
+        while (left) {
+            if (Accept('*'))
+                left = MakeBinary(MULT, std::move(left), ParseUnary());
+            else if (Accept('/'))
+                left = MakeBinary(DIV, std::move(left), ParseUnary());
+            else
+                break;
+        }
+        return left;
+    }
+
+    static std::unique_ptr<Node> MakeBinary(Ops operation, std::unique_ptr<Node> left, std::unique_ptr<Node> right) {
+        return right ? MakeNode(operation, std::move(left), std::move(right)) : nullptr;
+    }
+
+    std::unique_ptr<Node> ParseUnary() {
+        if (++mDepth > MAX_DEPTH)
+            return nullptr;
+        std::unique_ptr<Node> result;
+        if (Accept('-')) {
+            auto operand = ParseUnary();
+            result = operand ? MakeNode(NEG, std::move(operand)) : nullptr;
+        } else if (Accept('+')) {
+            result = ParseUnary();
+        } else {
+            result = ParsePrimary();
+        }
+        --mDepth;
+        return result;
+    }
+
+    std::unique_ptr<Node> ParsePrimary() {
+        SkipSpaces();
+        if (mPosition == mText.size())
+            return nullptr;
+        const char c = mText[mPosition];
+        if (IsDigit(c))
+            return ParseNumber();
+        if (Accept('(')) {
+            auto inner = ParseExpression();
+            return inner && Accept(')') ? std::move(inner) : nullptr;
+        }
+        if (!IsLetter(c))
+            return nullptr;
+        const size_t start = mPosition;
+        while (mPosition < mText.size() && (IsLetter(mText[mPosition]) || IsDigit(mText[mPosition])))
+            ++mPosition;
+        const std::string_view name = mText.substr(start, mPosition - start);
+        for (const auto& [function, operation] : FUNCTIONS) {
+            if (name != function)
+                continue;
+            if (!Accept('('))
+                return nullptr;
+            auto argument = ParseExpression();
+            return argument && Accept(')') ? MakeNode(operation, std::move(argument)) : nullptr;
+        }
+        auto node = MakeNode(PUSH_VAR, nullptr);
+        const int index = mExpression.VariableIndex(name);
+        if (index < 0) {
+            node->mIndex = static_cast<uint32_t>(mExpression.mVariables.size());
+            mExpression.mVariables.emplace_back(name);
+        } else {
+            node->mIndex = static_cast<uint32_t>(index);
+        }
+        return node;
+    }
+
+    std::unique_ptr<Node> ParseNumber() {
+        auto node = MakeNode(PUSH_CONST, nullptr);
+        const char* const first = mText.data() + mPosition;
+        const auto [end, ec] = dec_n::from_chars(first, mText.data() + mText.size(), node->mValue);
+        if (ec != std::errc{})
+            return nullptr;
+        mPosition += static_cast<size_t>(end - first);
+        return node;
+    }
+
+    std::string_view mText;
+    Expression& mExpression;
+    size_t mPosition = 0;
+    int mDepth = 0;
+};
+
+std::optional<Expression> Expression::Compile(std::string_view text, const dec_n::DecimalContext& context, size_t* error_position)
+{
+    Expression expression{context};
+    const dec_n::DecimalContext::Scope scope{expression.mContext};
+    Parser parser{text, expression};
+    const auto root = parser.Parse();
+    if (!root) {
+        if (error_position)
+            *error_position = parser.Position();
+        return std::nullopt;
+    }
+    expression.Fold(*root);
+    size_t depth = 0;
+    expression.Emit(*root, depth);
+    return expression;
+}
+
+int Expression::VariableIndex(std::string_view name) const
+{
+    for (size_t i = 0; i < mVariables.size(); ++i) {
+        if (mVariables[i] == name)
+            return static_cast<int>(i);
+    }
+    return -1;
+}
+
+void Expression::Fold(Node& node) const
+{
+    if (node.mOpcode == PUSH_CONST || node.mOpcode == PUSH_VAR)
+        return;
+    Fold(*node.mLeft);
+    if (node.mRight)
+        Fold(*node.mRight);
+    const bool is_constant = node.mLeft->mOpcode == PUSH_CONST && (!node.mRight || node.mRight->mOpcode == PUSH_CONST);
+    if (!is_constant)
+        return;
+    int error;
+    bool exact_sqrt;
+    const dec_n::Decimal none {};
+    auto value = apply(node.mOpcode, node.mLeft->mValue, node.mRight ? node.mRight->mValue : none, error, exact_sqrt);
+    // Ошибочные операции (например, деление на ноль) оставляются до вычисления, чтобы сообщить о них там.
+    if (error != NO_ERRORS || value.IsNotANumber())
+        return;
+    node.mOpcode = PUSH_CONST;
+    node.mValue = value;
+    node.mLeft.reset();
+    node.mRight.reset();
+}
+
+void Expression::Emit(const Node& node, size_t& depth)
+{
+    switch (node.mOpcode) {
+    case PUSH_CONST:
+        mCode.push_back({PUSH_CONST, static_cast<uint32_t>(mConstants.size())});
+        mConstants.push_back(node.mValue);
+        ++depth;
+        break;
+    case PUSH_VAR:
+        mCode.push_back({PUSH_VAR, node.mIndex});
+        ++depth;
+        break;
+    default:
+        Emit(*node.mLeft, depth);
+        if (node.mRight) {
+            Emit(*node.mRight, depth);
+            --depth;
+        }
+        mCode.push_back({node.mOpcode, 0});
+    }
+    if (depth > mStack.size())
+        mStack.resize(depth);
+}
+
+dec_n::Decimal Expression::Run(const dec_n::Decimal* values, int& error) const
+{
+    const dec_n::Decimal none {};
+    bool exact_sqrt;
+    size_t top = 0;
+    error = NO_ERRORS;
+    for (const auto& instruction : mCode) {
+        switch (instruction.mOpcode) {
+        case PUSH_CONST:
+            mStack[top++] = mConstants[instruction.mIndex];
+            break;
+        case PUSH_VAR:
+            mStack[top++] = values[instruction.mIndex];
+            break;
+        default:
+            if (instruction.mOpcode > SEPARATOR) {
+                mStack[top - 1] = apply(instruction.mOpcode, mStack[top - 1], none, error, exact_sqrt);
+            } else {
+                --top;
+                mStack[top - 1] = apply(instruction.mOpcode, mStack[top - 1], mStack[top], error, exact_sqrt);
+            }
+            if (error != NO_ERRORS)
+                return dec_n::Decimal{};
+        }
+    }
+    return mStack[0];
+}
+
+dec_n::Decimal Expression::Evaluate(std::span<const dec_n::Decimal> values, int& error) const
+{
+    assert(values.size() >= mVariables.size());
+    const dec_n::DecimalContext::Scope scope{mContext};
+    return Run(values.data(), error);
+}
+
+void Expression::EvaluateBatch(std::span<const dec_n::Decimal> values, std::span<dec_n::Decimal> out, std::span<int> errors) const
+{
+    const size_t width = mVariables.size();
+    assert(values.size() == out.size() * width);
+    assert(errors.size() == out.size());
+    const dec_n::DecimalContext::Scope scope{mContext};
+    for (size_t i = 0; i < out.size(); ++i)
+        out[i] = Run(values.data() + i * width, errors[i]);
+}
+
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "calculus_global.h"
+#include "calculus.h"
+#include "decimal.h"
+
+namespace calculus {
+
+/**
+ * @brief Скомпилированное выражение над числами Decimal.
+ * Текст разбирается в дерево (AST), в котором сворачиваются константные поддеревья, и дерево
+ * переводится в байткод стековой машины. Выражение вычисляется многократно для разных значений
+ * переменных без выделения памяти: стек нужной глубины выделяется один раз, при компиляции.
+ *
+ * Грамматика (пробелы игнорируются):
+ *   expression := term (('+' | '-') term)*
+ *   term       := unary (('*' | '/') unary)*
+ *   unary      := ('-' | '+') unary | primary
+ *   primary    := number | variable | function '(' expression ')' | '(' expression ')'
+ *   function   := sqrt | sqr | reciproc | neg
+ * Число записывается как в Decimal: цифры и, при необходимости, дробная часть после ',' или '.'.
+ * Переменная - идентификатор [A-Za-z_][A-Za-z0-9_]*, не совпадающий с именем функции.
+ *
+ * Операции выполняются так же, как в doIt (calculus::apply), в контексте, заданном при компиляции.
+ * Стек вычислений хранится в объекте, поэтому один объект нельзя вычислять из разных потоков одновременно.
+ */
+class CALCULUS_EXPORT Expression {
+public:
+    /**
+     * @brief Скомпилировать выражение.
+     * @param text Текст выражения.
+     * @param context Контекст (ширина), в котором разбираются числа, сворачиваются константы и вычисляется выражение.
+     * @param error_position Позиция первой ошибки разбора в text (может быть nullptr).
+     * @return Выражение или пусто при синтаксической ошибке.
+     */
+    static std::optional<Expression> Compile(std::string_view text, const dec_n::DecimalContext& context,
+                                             size_t* error_position = nullptr);
+
+    /**
+     * @brief Имена переменных в порядке первого появления в тексте: в этом порядке передаются их значения.
+     */
+    const std::vector<std::string>& Variables() const {
+        return mVariables;
+    }
+
+    /**
+     * @brief Индекс переменной или -1, если ее нет в выражении.
+     */
+    int VariableIndex(std::string_view name) const;
+
+    /**
+     * @brief Вычислить выражение.
+     * @param values Значения переменных в порядке Variables().
+     * @param error Код ошибки (Errors) первой неудачной операции.
+     * @return Результат; при ошибке - Decimal{}, как у doIt.
+     */
+    dec_n::Decimal Evaluate(std::span<const dec_n::Decimal> values, int& error) const;
+
+    /**
+     * @brief Вычислить выражение для набора строк: values[i * Variables().size() + j] - значение переменной j в строке i.
+     * Контекст устанавливается один раз на весь набор.
+     * @param out, errors Результаты и коды ошибок по строкам.
+     */
+    void EvaluateBatch(std::span<const dec_n::Decimal> values, std::span<dec_n::Decimal> out, std::span<int> errors) const;
+
+    /**
+     * @brief Длина байткода (число команд).
+     */
+    size_t Size() const {
+        return mCode.size();
+    }
+
+private:
+    /**
+     * @brief Код команды: загрузка константы или переменной, либо операция (значения совпадают с Ops).
+     */
+    enum Opcode : uint8_t {
+        PUSH_CONST = SEPARATOR, // Номер SEPARATOR не используется операциями.
+        PUSH_VAR = SEPARATOR_IO,
+    };
+
+    /**
+     * @brief Команда стековой машины: операция и индекс константы или переменной.
+     */
+    struct Instruction {
+        uint8_t mOpcode;
+        uint32_t mIndex;
+    };
+
+    struct Node;
+    class Parser;
+
+    explicit Expression(const dec_n::DecimalContext& context) : mContext{context} {}
+
+    /**
+     * @brief Свернуть константные поддеревья.
+     */
+    void Fold(Node& node) const;
+
+    /**
+     * @brief Выдать байткод для поддерева.
+     * @param depth Текущая глубина стека; обновляет mStack по наибольшей глубине.
+     */
+    void Emit(const Node& node, size_t& depth);
+
+    /**
+     * @brief Вычисление в уже установленном контексте.
+     */
+    dec_n::Decimal Run(const dec_n::Decimal* values, int& error) const;
+
+    dec_n::DecimalContext mContext;
+    std::vector<Instruction> mCode;
+    std::vector<dec_n::Decimal> mConstants;
+    std::vector<std::string> mVariables;
+
+    /**
+     * @brief Стек вычислений наибольшей нужной глубины.
+     */
+    mutable std::vector<dec_n::Decimal> mStack;
+};
+
+}
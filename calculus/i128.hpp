@@ -536,20 +536,7 @@ public:
     /**
          * @brief Возвращает строковое представление числа.
          */
-    [[nodiscard]] std::string toString() const
-    {
-        if (mSingular.is_nan()) return "nan";
-        if (mSingular.is_overflow()) return "inf";
-        if (mUnsigned == U128{0}) return "0";
-
-        std::string res = mUnsigned.toString();
-        if (mSign()) {
-            // Чтобы избежать лишних копирований, можно использовать конкатенацию,
-            // но большинство современных компиляторов оптимизируют это.
-            return "-" + res;
-        }
-        return res;
-    }
+    [[nodiscard]] std::string toString() const;
 
 private:
     /**
@@ -567,4 +554,53 @@ private:
          */
     Singular mSingular{false};
 };
+
+/**
+ * @brief Десятичная запись числа в буфер [first, last) в стиле std::to_chars: "nan", "inf" или [-]цифры.
+ * Память не выделяется.
+ * @return Указатель за последним записанным символом; value_too_large, если буфер мал.
+ */
+inline std::to_chars_result to_chars(char *first, char *last, const I128 &value) noexcept
+{
+    const auto write = [first, last](std::string_view s) -> std::to_chars_result {
+        if (last - first < static_cast<std::ptrdiff_t>(s.size()))
+            return {last, std::errc::value_too_large};
+        return {std::copy(s.begin(), s.end(), first), std::errc{}};
+    };
+    if (value.is_nan())
+        return write("nan");
+    if (value.is_overflow())
+        return write("inf");
+    if (value.is_negative())
+    {
+        if (first == last)
+            return {last, std::errc::value_too_large};
+        *first++ = '-';
+    }
+    return bignum::u128::to_chars(first, last, value.unsigned_part());
+}
+
+/**
+ * @brief Разбор записи [-]цифры из [first, last) в стиле std::from_chars.
+ * @return Указатель на первый неразобранный символ; invalid_argument, если цифр нет;
+ * result_out_of_range, если модуль не помещается в 128 бит (value при ошибках не меняется).
+ */
+inline std::from_chars_result from_chars(const char *first, const char *last, I128 &value) noexcept
+{
+    const bool negative = first != last && *first == '-';
+    U128 magnitude;
+    const auto result = bignum::u128::from_chars(first + (negative ? 1 : 0), last, magnitude);
+    if (result.ec == std::errc::invalid_argument)
+        return {first, result.ec};
+    if (result.ec == std::errc{})
+        value = I128{magnitude, negative};
+    return result;
+}
+
+inline std::string I128::toString() const
+{
+    char buffer[41];
+    const auto [end, ec] = to_chars(std::begin(buffer), std::end(buffer), *this);
+    return std::string(buffer, end);
+}
 }
@@ -0,0 +1,174 @@
+#include "mul_kernels.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define USE_BMI2_ADX_KERNELS
+#define BMI2_ADX_TARGET __attribute__((target("bmi2,adx")))
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define USE_BMI2_ADX_KERNELS
+#define BMI2_ADX_TARGET
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace bignum::kernels
+{
+
+namespace {
+
+using u64 = uint64_t;
+
+U256 mult_ext_generic(const U128 &x, const U128 &y) noexcept
+{
+    const U128 ll = U128::mult_ext(x.low(), y.low());
+    const U128 lh = U128::mult_ext(x.low(), y.high());
+    const U128 hl = U128::mult_ext(x.high(), y.low());
+    const U128 hh = U128::mult_ext(x.high(), y.high());
+    const U128 mid = lh + hl;
+    const u64 mid_carry = mid < lh ? 1 : 0;
+    const U128 low = ll + U128{0, mid.low()};
+    const u64 low_carry = low < ll ? 1 : 0;
+    const U128 high = hh + U128{mid.high(), mid_carry} + U128{low_carry};
+    return {low, high};
+}
+
+U256 square_ext_generic(const U128 &x) noexcept
+{
+    const U128 ll = U128::mult_ext(x.low(), x.low());
+    const U128 lh = U128::mult_ext(x.low(), x.high());
+    const U128 hh = U128::mult_ext(x.high(), x.high());
+    const u64 mid_carry = lh.high() >> 63;
+    const U128 mid = lh << 1;
+    const U128 low = ll + U128{0, mid.low()};
+    const u64 low_carry = low < ll ? 1 : 0;
+    const U128 high = hh + U128{mid.high(), mid_carry} + U128{low_carry};
+    return {low, high};
+}
+
+/**
+ * @brief Общая часть приведения Монтгомери: (t + q * n) / 2^128 с финальным вычитанием.
+ */
+inline U128 finish_redc(const U256 &t, const U256 &qn, const U128 &n) noexcept
+{
+    // Младшая половина суммы t + q * n равна нулю; перенос из нее есть, если t.low() != 0.
+    U128 u = t.high() + qn.high();
+    bool carry = u < qn.high();
+    if (t.low() != 0)
+    {
+        ++u;
+        carry |= (u == 0);
+    }
+    if (carry || u >= n)
+        u -= n;
+    return u;
+}
+
+U128 montgomery_redc_generic(const U256 &t, const U128 &n, const U128 &n_inv) noexcept
+{
+    const U128 q = t.low() * n_inv;
+    return finish_redc(t, mult_ext_generic(q, n), n);
+}
+
+#if defined(USE_BMI2_ADX_KERNELS)
+using ull = unsigned long long;
+
+BMI2_ADX_TARGET U256 mult_ext_bmi2_adx(const U128 &x, const U128 &y) noexcept
+{
+    ull h00, h01, h10, h11;
+    const ull l00 = _mulx_u64(x.low(), y.low(), &h00);
+    const ull l01 = _mulx_u64(x.low(), y.high(), &h01);
+    const ull l10 = _mulx_u64(x.high(), y.low(), &h10);
+    const ull l11 = _mulx_u64(x.high(), y.high(), &h11);
+    // Две независимые цепочки переносов (adcx по CF и adox по OF): строки x.low * y и x.high * y.
+    ull t1, t2, t3, r1, r2, r3;
+    unsigned char c = _addcarryx_u64(0, h00, l01, &t1);
+    c = _addcarryx_u64(c, h01, l11, &t2);
+    _addcarryx_u64(c, h11, 0, &t3);
+    unsigned char o = _addcarryx_u64(0, t1, l10, &r1);
+    o = _addcarryx_u64(o, t2, h10, &r2);
+    _addcarryx_u64(o, t3, 0, &r3);
+    return {U128{l00, r1}, U128{r2, r3}};
+}
+
+BMI2_ADX_TARGET U256 square_ext_bmi2_adx(const U128 &x) noexcept
+{
+    ull h00, h01, h11;
+    const ull l00 = _mulx_u64(x.low(), x.low(), &h00);
+    const ull l01 = _mulx_u64(x.low(), x.high(), &h01);
+    const ull l11 = _mulx_u64(x.high(), x.high(), &h11);
+    // Удвоенное среднее произведение (до 129 бит) складывается с крайними.
+    ull d1, d2, r1, r2, r3;
+    unsigned char c = _addcarryx_u64(0, l01, l01, &d1);
+    c = _addcarryx_u64(c, h01, h01, &d2);
+    const ull d3 = c;
+    unsigned char o = _addcarryx_u64(0, h00, d1, &r1);
+    o = _addcarryx_u64(o, l11, d2, &r2);
+    _addcarryx_u64(o, h11, d3, &r3);
+    return {U128{l00, r1}, U128{r2, r3}};
+}
+
+BMI2_ADX_TARGET U128 montgomery_redc_bmi2_adx(const U256 &t, const U128 &n, const U128 &n_inv) noexcept
+{
+    // q = t.low() * n_inv mod 2^128: достаточно трех умножений.
+    ull q_high;
+    const ull q_low = _mulx_u64(t.low().low(), n_inv.low(), &q_high);
+    q_high += t.low().low() * n_inv.high() + t.low().high() * n_inv.low();
+    return finish_redc(t, mult_ext_bmi2_adx(U128{q_low, q_high}, n), n);
+}
+
+bool cpu_has_bmi2_adx() noexcept
+{
+    constexpr unsigned BMI2_BIT = 1u << 8;
+    constexpr unsigned ADX_BIT = 1u << 19;
+#if defined(_MSC_VER) && !defined(__clang__)
+    int regs[4];
+    __cpuid(regs, 0);
+    if (regs[0] < 7)
+        return false;
+    __cpuidex(regs, 7, 0);
+    const unsigned ebx = static_cast<unsigned>(regs[1]);
+#else
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+        return false;
+#endif
+    return (ebx & BMI2_BIT) && (ebx & ADX_BIT);
+}
+#endif
+
+const MulKernels GENERIC{"generic", &mult_ext_generic, &square_ext_generic, &montgomery_redc_generic};
+
+#if defined(USE_BMI2_ADX_KERNELS)
+const MulKernels BMI2_ADX{"bmi2+adx", &mult_ext_bmi2_adx, &square_ext_bmi2_adx, &montgomery_redc_bmi2_adx};
+#endif
+
+/**
+ * @brief Выбор ядер при загрузке библиотеки, а не при первом вызове.
+ */
+[[maybe_unused]] const MulKernels &g_selected_at_load = mul_kernels();
+
+}
+
+const MulKernels &generic_kernels() noexcept
+{
+    return GENERIC;
+}
+
+const MulKernels *bmi2_adx_kernels() noexcept
+{
+#if defined(USE_BMI2_ADX_KERNELS)
+    static const bool supported = cpu_has_bmi2_adx();
+    return supported ? &BMI2_ADX : nullptr;
+#else
+    return nullptr;
+#endif
+}
+
+const MulKernels &mul_kernels() noexcept
+{
+    static const MulKernels &active = bmi2_adx_kernels() ? *bmi2_adx_kernels() : generic_kernels();
+    return active;
+}
+
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "calculus_global.h"
+#include "u128.hpp"
+#include "ubig.hpp"
+
+namespace bignum::kernels
+{
+
+using U128 = bignum::u128::U128;
+using U256 = bignum::UBig<U128>;
+
+/**
+ * @brief Набор ядер длинного умножения 128x128 -> 256 бит.
+ * Существует в нескольких вариантах под разные наборы инструкций; лучший выбирается
+ * по CPUID один раз при загрузке библиотеки, так что один бинарник работает на любом x86-64.
+ */
+struct MulKernels
+{
+    /**
+     * @brief Название варианта (для журналов и тестов).
+     */
+    const char *name;
+
+    /**
+     * @brief Полное произведение x * y.
+     */
+    U256 (*mult_ext)(const U128 &x, const U128 &y) noexcept;
+
+    /**
+     * @brief Полный квадрат x^2.
+     */
+    U256 (*square_ext)(const U128 &x) noexcept;
+
+    /**
+     * @brief Приведение Монтгомери: t * 2^-128 mod n.
+     * @param t Приводимое число, t < n * 2^128.
+     * @param n Нечетный модуль.
+     * @param n_inv Величина -n^-1 mod 2^128.
+     * @return Результат на отрезке [0, n).
+     */
+    U128 (*montgomery_redc)(const U256 &t, const U128 &n, const U128 &n_inv) noexcept;
+};
+
+/**
+ * @brief Универсальные ядра: 64-битные умножения через __int128 (или _umul128).
+ */
+CALCULUS_EXPORT const MulKernels &generic_kernels() noexcept;
+
+/**
+ * @brief Ядра на инструкциях mulx/adcx/adox (BMI2 + ADX).
+ * @return nullptr, если процессор их не поддерживает или сборка не для x86-64.
+ */
+CALCULUS_EXPORT const MulKernels *bmi2_adx_kernels() noexcept;
+
+/**
+ * @brief Лучшие доступные на данном процессоре ядра.
+ */
+CALCULUS_EXPORT const MulKernels &mul_kernels() noexcept;
+
+}
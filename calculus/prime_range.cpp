@@ -0,0 +1,127 @@
+#include "prime_range.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+
+namespace u128::utils
+{
+
+namespace {
+
+/**
+ * @brief Вычеты по модулю 30, взаимно простые с 30: номер бита в байте сегмента.
+ */
+constexpr uint64_t RESIDUES[8] {1, 7, 11, 13, 17, 19, 23, 29};
+
+/**
+ * @brief Шаги колеса: расстояние до следующего взаимно простого с 30 вычета.
+ */
+constexpr uint64_t WHEEL_STEPS[8] {6, 4, 2, 4, 2, 4, 6, 2};
+
+/**
+ * @brief Индекс вычета на колесе по остатку от деления на 30; -1 для чисел, кратных 2, 3 или 5.
+ */
+constexpr auto WHEEL_INDEX = [] {
+    std::array<int, 30> idx{};
+    idx.fill(-1);
+    for (int i = 0; i < 8; ++i)
+        idx[RESIDUES[i]] = i;
+    return idx;
+}();
+
+uint64_t isqrt64(uint64_t x)
+{
+    uint64_t r = static_cast<uint64_t>(std::sqrt(static_cast<double>(x)));
+    while (r * r > x)
+        --r;
+    while ((r + 1) * (r + 1) <= x)
+        ++r;
+    return r;
+}
+
+}
+
+PrimeRange::PrimeRange(u64 first, u64 last) : mFirst{first}, mLast{last}
+{
+    if (last < 7 || first > last) {
+        mDone = true;
+        return;
+    }
+    // Базовые простые 7 <= p <= sqrt(last) получаем тем же решетом, рекурсивно.
+    const u64 root = isqrt64(last);
+    if (root >= 7) {
+        const u64 low = (first / 30) * 30;
+        PrimeRange base{7, root};
+        for (const auto p : base) {
+            u64 k = std::max(p, (low + p - 1) / p);
+            while (WHEEL_INDEX[k % 30] < 0)
+                ++k;
+            mBase.push_back({p, p * k, static_cast<unsigned>(WHEEL_INDEX[k % 30])});
+        }
+    }
+    mSegmentStart = first / 30;
+}
+
+void PrimeRange::sieve_segment()
+{
+    const size_t length = static_cast<size_t>(std::min<u64>(SEGMENT_BYTES, mLast / 30 - mSegmentStart + 1));
+    mSegment.assign(length, 0xFF);
+    if (mSegmentStart == 0)
+        mSegment[0] &= ~1u; // Единица не является простым.
+    const u64 high = 30 * (mSegmentStart + length);
+    for (auto& s : mBase) {
+        // Вычеркивание начинается с p^2, поэтому следующие базовые простые сегмент не затрагивают.
+        if (s.p * s.p >= high)
+            break;
+        u64 m = s.multiple;
+        unsigned w = s.wheel;
+        while (m < high) {
+            mSegment[m / 30 - mSegmentStart] &= ~(1u << WHEEL_INDEX[m % 30]);
+            m += s.p * WHEEL_STEPS[w];
+            w = (w + 1) & 7;
+        }
+        s.multiple = m;
+        s.wheel = w;
+    }
+    mBytePos = 0;
+}
+
+PrimeRange::u64 PrimeRange::next()
+{
+    static constexpr u64 SMALL[3] {2, 3, 5};
+    while (mSmallIdx < 3) {
+        const u64 p = SMALL[mSmallIdx++];
+        if (p >= mFirst && p <= mLast)
+            return p;
+    }
+    if (mDone)
+        return 0;
+    for (;;) {
+        if (mBits == 0) {
+            if (mBytePos == mSegment.size()) {
+                if (!mSegment.empty())
+                    mSegmentStart += mSegment.size();
+                if (mSegmentStart > mLast / 30) {
+                    mDone = true;
+                    return 0;
+                }
+                sieve_segment();
+            }
+            mBits = mSegment[mBytePos++];
+            continue;
+        }
+        const int i = std::countr_zero(mBits);
+        mBits &= mBits - 1;
+        const u64 n = 30 * (mSegmentStart + mBytePos - 1) + RESIDUES[i];
+        if (n > mLast) {
+            mDone = true;
+            return 0;
+        }
+        if (n >= mFirst)
+            return n;
+    }
+}
+
+}
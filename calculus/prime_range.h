@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <iterator> // std::default_sentinel_t
+#include <vector>
+
+namespace u128::utils
+{
+
+/**
+ * @brief Сегментированное решето Эратосфена с колесом по модулю 30.
+ * Перечисляет простые числа отрезка [first, last] потоково, в порядке возрастания.
+ * Каждый байт сегмента хранит 30 последовательных чисел: по биту на каждый вычет,
+ * взаимно простой с 30 (1, 7, 11, 13, 17, 19, 23, 29). Сегмент помещается в кэш L1.
+ * Память: сегмент плюс базовые простые до sqrt(last), т.е. не зависит от длины отрезка.
+ * Верхняя граница last ограничена 2^62.
+ */
+class PrimeRange
+{
+public:
+    using u64 = uint64_t;
+
+    /**
+     * @brief Размер сегмента в байтах (30 чисел на байт).
+     */
+    static constexpr size_t SEGMENT_BYTES = 32 * 1024;
+
+    /**
+     * @brief Конструктор.
+     * @param first Начало отрезка (включительно).
+     * @param last Конец отрезка (включительно).
+     */
+    PrimeRange(u64 first, u64 last);
+
+    /**
+     * @brief Однопроходный итератор по простым числам.
+     */
+    class iterator
+    {
+        PrimeRange* mRange = nullptr;
+        u64 mValue = 0;
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = u64;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        iterator(PrimeRange* range, u64 value) : mRange{range}, mValue{value} {}
+
+        u64 operator*() const { return mValue; }
+        iterator& operator++() {
+            mValue = mRange->next();
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+        bool operator==(std::default_sentinel_t) const { return mValue == 0; }
+    };
+
+    /**
+     * @brief Начать перечисление. Повторный вызов продолжает с текущего места.
+     */
+    iterator begin() { return {this, next()}; }
+    std::default_sentinel_t end() const { return {}; }
+
+private:
+    /**
+     * @brief Состояние базового простого: следующее вычеркиваемое кратное и позиция на колесе.
+     */
+    struct Sieving {
+        u64 p;
+        u64 multiple;
+        unsigned wheel;
+    };
+
+    /**
+     * @brief Следующее простое число или 0, если отрезок исчерпан.
+     */
+    u64 next();
+
+    /**
+     * @brief Просеять очередной сегмент, начиная с байта mSegmentStart.
+     */
+    void sieve_segment();
+
+    u64 mFirst;
+    u64 mLast;
+    std::vector<Sieving> mBase;
+    std::vector<uint8_t> mSegment;
+    u64 mSegmentStart = 0;   // Номер первого байта сегмента (число = 30 * байт).
+    size_t mBytePos = 0;     // Текущий байт внутри сегмента.
+    unsigned mBits = 0;      // Непрочитанные биты текущего байта.
+    unsigned mSmallIdx = 0;  // Индекс среди простых 2, 3, 5.
+    bool mDone = false;
+};
+
+}
@@ -0,0 +1,447 @@
+/**
+ * @brief Класс для арифметики 128-битных знаковых целых чисел в дополнительном коде с переполнением.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <compare>
+#include <string>
+#include <utility>
+#include "u128.hpp" // U128
+#include "i128.hpp" // I128
+
+namespace bignum::s128
+{
+using U128 = bignum::u128::U128;
+using I128 = bignum::i128::I128;
+
+using u64 = uint64_t;
+
+/**
+ * @brief Знаковое 128-битное число в дополнительном коде, ровно 16 байт.
+ * Сингулярности кодируются зарезервированными значениями вблизи -2^127, отдельного поля нет:
+ *  - "нечисло" (NaN): -2^127,
+ *  - переполнение (inf): -2^127 + 1.
+ * Значение 2^127 - 1 тоже не используется, чтобы диапазон обычных чисел [-(2^127 - 2), 2^127 - 2] был
+ * симметричен, как у I128: смена знака и модуль никогда не переполняются. Модуль на один бит короче, чем у I128.
+ * Сложение, вычитание и умножение определяют переполнение через __builtin_*_overflow, а
+ * распространение сингулярностей сводится к условным пересылкам вместо ветвлений по знаку.
+ * Интерфейс повторяет I128, поэтому S128 может служить основой Decimal (см. DECIMAL_S128).
+ */
+class S128
+{
+public:
+    /**
+     * @brief Конструктор по умолчанию: ноль.
+     */
+    constexpr S128() noexcept = default;
+
+    /**
+     * @brief Конструктор с параметром.
+     */
+    constexpr S128(u64 low) noexcept : mLow{low}, mHigh{0}
+    {
+        ;
+    }
+
+    /**
+     * @brief Конструктор из модуля и знака (как у I128). Модуль вне диапазона дает переполнение.
+     */
+    constexpr S128(U128 magnitude, bool negative = false) noexcept
+    {
+        if (magnitude > MAX_MAGNITUDE)
+        {
+            *this = overflow();
+            return;
+        }
+        const U128 x = negative ? -magnitude : magnitude;
+        mLow = x.low();
+        mHigh = x.high();
+    }
+
+    /**
+     * @brief Преобразование из I128 с сохранением сингулярностей.
+     */
+    S128(const I128 &x) noexcept
+    {
+        if (x.is_nan())
+            *this = nan();
+        else if (x.is_overflow())
+            *this = overflow();
+        else
+            *this = S128{x.unsigned_part(), x.is_negative()};
+    }
+
+    /**
+     * @brief Число "нечисло".
+     */
+    static constexpr S128 nan() noexcept { return from_bits(0, SIGN_BIT); }
+
+    /**
+     * @brief Число "переполнение".
+     */
+    static constexpr S128 overflow() noexcept { return from_bits(1, SIGN_BIT); }
+
+    /**
+     * @brief Оператор сравнения.
+     */
+    constexpr bool operator==(const S128 &other) const noexcept
+    {
+        return !is_singular() && !other.is_singular() && mLow == other.mLow && mHigh == other.mHigh;
+    }
+
+    /**
+     * @brief Остальные операторы сравнения. Сингулярности несравнимы.
+     */
+    constexpr std::partial_ordering operator<=>(const S128 &other) const noexcept
+    {
+        if (is_singular() || other.is_singular())
+            return std::partial_ordering::unordered;
+        if (mHigh != other.mHigh)
+            return static_cast<int64_t>(mHigh) <=> static_cast<int64_t>(other.mHigh);
+        return mLow <=> other.mLow;
+    }
+
+    constexpr bool is_singular() const noexcept
+    {
+        return mHigh == SIGN_BIT && mLow <= 1;
+    }
+
+    constexpr bool is_overflow() const noexcept
+    {
+        return mHigh == SIGN_BIT && mLow == 1;
+    }
+
+    constexpr bool is_nan() const noexcept
+    {
+        return mHigh == SIGN_BIT && mLow == 0;
+    }
+
+    constexpr bool is_zero() const noexcept
+    {
+        return (mLow | mHigh) == 0;
+    }
+
+    /**
+     * @brief x < 0
+     */
+    constexpr bool is_negative() const noexcept
+    {
+        return static_cast<int64_t>(mHigh) < 0 && !is_singular();
+    }
+
+    /**
+     * @brief x > 0
+     */
+    constexpr bool is_positive() const noexcept
+    {
+        return static_cast<int64_t>(mHigh) >= 0 && !is_zero();
+    }
+
+    /**
+     * @brief x >= 0
+     */
+    constexpr bool is_nonegative() const noexcept
+    {
+        return static_cast<int64_t>(mHigh) >= 0;
+    }
+
+    constexpr void set_overflow() noexcept
+    {
+        *this = overflow();
+    }
+
+    constexpr void set_nan() noexcept
+    {
+        *this = nan();
+    }
+
+    /**
+     * @brief Возвращает абсолютное значение числа. Всегда представимо, сингулярности сохраняются.
+     */
+    constexpr S128 abs() const noexcept
+    {
+        return is_negative() ? -*this : *this;
+    }
+
+    /**
+     * @brief Знак минус.
+     */
+    constexpr S128 operator-() const noexcept
+    {
+        if (is_singular())
+            return *this;
+        const U128 x = -bits();
+        return from_bits(x.low(), x.high());
+    }
+
+    /**
+     * @brief Оператор суммирования.
+     */
+    constexpr S128 operator+(const S128 &rhs) const noexcept
+    {
+        S128 result;
+        bool carry_out;
+#if defined(__SIZEOF_INT128__)
+        __int128 r;
+        carry_out = __builtin_add_overflow(value(), rhs.value(), &r);
+        result = from_value(r);
+#else
+        const U128 r = bits() + rhs.bits();
+        carry_out = ((bits() ^ r) & (rhs.bits() ^ r)).high() >> 63;
+        result = from_bits(r.low(), r.high());
+#endif
+        return settle(result, carry_out, rhs);
+    }
+
+    constexpr S128 &operator+=(const S128 &rhs) noexcept
+    {
+        *this = *this + rhs;
+        return *this;
+    }
+
+    /**
+     * @brief Оператор вычитания.
+     */
+    constexpr S128 operator-(const S128 &rhs) const noexcept
+    {
+        S128 result;
+        bool carry_out;
+#if defined(__SIZEOF_INT128__)
+        __int128 r;
+        carry_out = __builtin_sub_overflow(value(), rhs.value(), &r);
+        result = from_value(r);
+#else
+        const U128 r = bits() - rhs.bits();
+        carry_out = ((bits() ^ rhs.bits()) & (bits() ^ r)).high() >> 63;
+        result = from_bits(r.low(), r.high());
+#endif
+        return settle(result, carry_out, rhs);
+    }
+
+    constexpr S128 &operator-=(const S128 &rhs) noexcept
+    {
+        *this = *this - rhs;
+        return *this;
+    }
+
+    /**
+     * @brief Оператор умножения.
+     */
+    constexpr S128 operator*(const S128 &rhs) const noexcept
+    {
+#if defined(__SIZEOF_INT128__) && !defined(__clang__)
+        __int128 r;
+        const bool carry_out = __builtin_mul_overflow(value(), rhs.value(), &r);
+        return settle(from_value(r), carry_out, rhs);
+#else
+        // Clang для __int128 обращается к __muloti4 из compiler-rt, которого нет в libgcc: считаем по модулям.
+        const U128 a = abs().bits();
+        const U128 b = rhs.abs().bits();
+        const bool negative = is_negative() != rhs.is_negative();
+        bool carry_out = a.high() != 0 && b.high() != 0;
+        const U128 low = U128::mult_ext(a.low(), b.low());
+        const U128 cross1 = U128::mult_ext(a.high(), b.low());
+        const U128 cross2 = U128::mult_ext(a.low(), b.high());
+        const U128 cross = cross1 + cross2;
+        carry_out |= cross1.high() != 0 || cross2.high() != 0 || cross < cross1;
+        const U128 magnitude = low + U128{0, cross.low()};
+        carry_out |= magnitude < low;
+        const S128 result = carry_out ? overflow() : S128{magnitude, negative};
+        return settle(result, carry_out, rhs);
+#endif
+    }
+
+    constexpr S128 operator*(u64 rhs) const noexcept
+    {
+        return *this * S128{rhs};
+    }
+
+    constexpr S128 &operator*=(const S128 &rhs) noexcept
+    {
+        *this = *this * rhs;
+        return *this;
+    }
+
+    /**
+     * @brief Оператор половинчатого деления. Частное округляется вниз, остаток неотрицателен (как у I128).
+     */
+    constexpr std::pair<S128, u64> operator/(u64 rhs) const noexcept
+    {
+        assert(rhs != 0);
+        if (is_singular())
+            return {*this, 0};
+        const U128 a = abs().bits();
+        U128 q = a / U128{rhs};
+        u64 r = (a - q * U128{rhs}).low();
+        if (is_negative() && r != 0)
+        {
+            q += U128{1};
+            r = rhs - r;
+        }
+        return {S128{q, is_negative()}, r};
+    }
+
+    /**
+     * @brief Оператор деления. Частное округляется вниз, знак остатка совпадает со знаком делителя (как у I128).
+     */
+    constexpr std::pair<S128, S128> operator/(const S128 &rhs) const noexcept
+    {
+        assert(!rhs.is_zero());
+        if (is_nan() || rhs.is_nan())
+            return {nan(), S128{0}};
+        if (is_overflow() || rhs.is_overflow())
+            return {overflow(), S128{0}};
+        const U128 a = abs().bits();
+        const U128 b = rhs.abs().bits();
+        U128 q = a / b;
+        U128 r = a - q * b;
+        const bool negative = is_negative() != rhs.is_negative();
+        if (negative && r != 0)
+        {
+            q += U128{1};
+            r = b - r;
+        }
+        return {S128{q, negative}, S128{r, rhs.is_negative()}};
+    }
+
+    /**
+     * @brief Количество битов, требуемое для представления модуля числа.
+     */
+    constexpr u64 bit_width() const noexcept
+    {
+        return unsigned_part().bit_width();
+    }
+
+    /**
+     * @brief Возвращает модуль числа.
+     */
+    constexpr U128 unsigned_part() const noexcept
+    {
+        return abs().bits();
+    }
+
+    /**
+     * @brief Возвращает строковое представление числа.
+     */
+    [[nodiscard]] std::string toString() const;
+
+private:
+    static constexpr u64 SIGN_BIT = 1ull << 63;
+
+    /**
+     * @brief Наибольший модуль обычного числа: 2^127 - 2 для обоих знаков.
+     */
+    static constexpr U128 MAX_MAGNITUDE = U128{~0ull - 1, SIGN_BIT - 1};
+
+    static constexpr S128 from_bits(u64 low, u64 high) noexcept
+    {
+        S128 result;
+        result.mLow = low;
+        result.mHigh = high;
+        return result;
+    }
+
+    constexpr U128 bits() const noexcept
+    {
+        return U128{mLow, mHigh};
+    }
+
+#if defined(__SIZEOF_INT128__)
+    constexpr __int128 value() const noexcept
+    {
+        return static_cast<__int128>((static_cast<unsigned __int128>(mHigh) << 64) | mLow);
+    }
+
+    static constexpr S128 from_value(__int128 x) noexcept
+    {
+        const auto u = static_cast<unsigned __int128>(x);
+        return from_bits(static_cast<u64>(u), static_cast<u64>(u >> 64));
+    }
+#endif
+
+    /**
+     * @brief Попадает ли значение на одно из трех зарезервированных: 2^127 - 1, -2^127 или -2^127 + 1.
+     * Они идут подряд, поэтому после сдвига на единицу проверка сводится к одному сравнению старшего слова.
+     */
+    constexpr bool is_reserved() const noexcept
+    {
+        const U128 shifted = bits() + U128{1};
+        return shifted.high() == SIGN_BIT && shifted.low() <= 2;
+    }
+
+    /**
+     * @brief Итог операции: "нечисло" заразно и старше переполнения; переполнением считаются
+     * перенос, сингулярный операнд и попадание результата на зарезервированные значения.
+     */
+    constexpr S128 settle(const S128 &result, bool carry_out, const S128 &rhs) const noexcept
+    {
+        const bool nan_in = is_nan() | rhs.is_nan();
+        const bool overflow_out = carry_out | is_singular() | rhs.is_singular() | result.is_reserved();
+        const u64 low = nan_in ? 0 : (overflow_out ? 1 : result.mLow);
+        const u64 high = (nan_in | overflow_out) ? SIGN_BIT : result.mHigh;
+        return from_bits(low, high);
+    }
+
+    /**
+     * @brief Младшее и старшее слова дополнительного кода.
+     */
+    u64 mLow{0};
+    u64 mHigh{0};
+};
+
+static_assert(sizeof(S128) == 16);
+
+/**
+ * @brief Десятичная запись числа в буфер [first, last) в стиле std::to_chars: "nan", "inf" или [-]цифры.
+ * @return Указатель за последним записанным символом; value_too_large, если буфер мал.
+ */
+inline std::to_chars_result to_chars(char *first, char *last, const S128 &value) noexcept
+{
+    const auto write = [first, last](std::string_view s) -> std::to_chars_result {
+        if (last - first < static_cast<std::ptrdiff_t>(s.size()))
+            return {last, std::errc::value_too_large};
+        return {std::copy(s.begin(), s.end(), first), std::errc{}};
+    };
+    if (value.is_nan())
+        return write("nan");
+    if (value.is_overflow())
+        return write("inf");
+    if (value.is_negative())
+    {
+        if (first == last)
+            return {last, std::errc::value_too_large};
+        *first++ = '-';
+    }
+    return bignum::u128::to_chars(first, last, value.unsigned_part());
+}
+
+/**
+ * @brief Разбор записи [-]цифры из [first, last) в стиле std::from_chars.
+ * @return Указатель на первый неразобранный символ; invalid_argument, если цифр нет;
+ * result_out_of_range, если число вне диапазона S128 (value при ошибках не меняется).
+ */
+inline std::from_chars_result from_chars(const char *first, const char *last, S128 &value) noexcept
+{
+    const bool negative = first != last && *first == '-';
+    U128 magnitude;
+    auto result = bignum::u128::from_chars(first + (negative ? 1 : 0), last, magnitude);
+    if (result.ec == std::errc::invalid_argument)
+        return {first, result.ec};
+    if (result.ec != std::errc{})
+        return result;
+    const S128 x{magnitude, negative};
+    if (x.is_overflow())
+        return {result.ptr, std::errc::result_out_of_range};
+    value = x;
+    return result;
+}
+
+inline std::string S128::toString() const
+{
+    char buffer[41];
+    const auto [end, ec] = to_chars(std::begin(buffer), std::end(buffer), *this);
+    return std::string(buffer, end);
+}
+}
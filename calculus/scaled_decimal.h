@@ -0,0 +1,487 @@
+/**
+ * @brief Альтернативное представление Decimal: одно знаковое 128-битное целое, масштабированное на 10^width.
+ */
+
+#pragma once
+
+#include <array>       // std::array
+#include <charconv>    // std::to_chars_result, std::from_chars_result
+#include <type_traits> // std::integral_constant
+#include <utility>     // std::pair, std::integer_sequence
+#include "decimal.h"   // Decimal, chars
+#include "s128.hpp"    // S128
+#include "ubig.hpp"    // UBig
+
+namespace dec_n {
+
+/**
+ * @brief Число с фиксированной запятой x = mValue / 10^W, где ширина W задана при компиляции.
+ * Сложение и вычитание - одна операция над 128-битным целым, умножение и деление - одно
+ * расширенное (256-битное) умножение и одно деление; знаменатель 10^W - константа, поэтому деление
+ * на него сводится к умножениям и сдвигам на предвычисленную обратную величину.
+ * Семантика совпадает с Decimal: результат округляется до W знаков в режиме текущего контекста
+ * (Decimal::GetRounding), в режиме отбрасывания "все девятки" в дробной части округляются вверх,
+ * переполнение дает inf, а неопределенность - NaN.
+ * Отличия от Decimal:
+ *  - модуль числа не превышает (2^127 - 2) / 10^W, т.е. целая часть на log2(10^W) бит короче;
+ *  - отрицательный ноль не различается: ноль всегда записывается без знака.
+ * Ширина не зависит от Decimal::SetWidth, так что числа разной точности могут
+ * вычисляться одновременно в разных потоках.
+ */
+template <int W>
+class FixedDecimal {
+    static_assert(W >= 0 && W <= Decimal::MaxWidth(), "Ширина вне диапазона Decimal");
+
+    using U256 = bignum::UBig<U128>;
+
+public:
+    using Value = bignum::s128::S128;
+
+    /**
+     * @brief Количество цифр после запятой.
+     */
+    static constexpr int WIDTH = W;
+
+    /**
+     * @brief Знаменатель 10^W с предвычисленной обратной величиной.
+     */
+    static constexpr bignum::u128::Divider<U128> DENOMINATOR{bignum::u128::pow10(W)};
+
+    /**
+     * @brief Конструктор по умолчанию: NaN, как у Decimal.
+     */
+    constexpr FixedDecimal() noexcept = default;
+
+    /**
+     * @brief Преобразование из Decimal: дробная часть приводится от текущей ширины Decimal
+     * к W (лишние цифры округляются в режиме контекста); вне диапазона - inf.
+     */
+    explicit FixedDecimal(const Decimal& x) noexcept {
+        if (x.IsOverflowed()) {
+            mValue = Value::overflow();
+            return;
+        }
+        if (x.IsNotANumber())
+            return;
+        const int width = Decimal::GetWidth();
+        U128 fraction = x.Nominator().unsigned_part();
+        auto remainder = rounding::EXACT;
+        if (width <= W) {
+            fraction *= bignum::u128::pow10(W - width);
+        } else {
+            const U128 step = bignum::u128::pow10(width - W);
+            const U128 kept = fraction / step;
+            remainder = rounding::Classify(fraction - kept * step, step);
+            fraction = kept;
+        }
+        const auto& magnitude = U256::mult_ext(x.IntegerPart().unsigned_part(), DENOMINATOR.divisor()) + U256{fraction};
+        mValue = FromMagnitude(magnitude, x.IsNegative(), remainder).mValue;
+    }
+
+    /**
+     * @brief Число из готового масштабированного значения, value = x * 10^W.
+     */
+    static constexpr FixedDecimal FromScaled(const Value& value) noexcept {
+        FixedDecimal result;
+        result.mValue = value;
+        return result;
+    }
+
+    /**
+     * @brief Число из 256-битного модуля масштабированного значения и знака, с коррекцией
+     * всех девяток в режиме отбрасывания; не помещающийся в 127 бит модуль дает inf.
+     * @param remainder Класс отброшенного остатка: модуль увеличивается на единицу, если этого
+     * требует режим округления текущего контекста (шаг округления Decimal).
+     */
+    static FixedDecimal FromMagnitude(U256 magnitude, bool negative, rounding::Remainder remainder = rounding::EXACT) noexcept {
+        if (rounding::Increment(Decimal::GetRounding(), remainder, negative, (magnitude.low().low() & 1) != 0))
+            magnitude += U256{1};
+        if (magnitude.high() != 0)
+            return FromScaled(Value::overflow());
+        return Settle(Value{magnitude.low(), negative});
+    }
+
+    /**
+     * @brief Масштабированное значение x * 10^W.
+     */
+    constexpr const Value& Scaled() const noexcept {
+        return mValue;
+    }
+
+    /**
+     * @brief Преобразование в Decimal; при ширине Decimal меньше W лишние цифры округляются в режиме контекста.
+     */
+    Decimal ToDecimal() const {
+        Decimal result;
+        if (IsOverflowed()) {
+            result.SetInfinity();
+            return result;
+        }
+        if (IsNotANumber()) {
+            result.SetNotANumber();
+            return result;
+        }
+        U128 fraction;
+        const U128 integer = DENOMINATOR.divide(mValue.unsigned_part(), &fraction);
+        const bool negative = mValue.is_negative();
+        result.SetDecimal(Integer{integer, negative && integer != 0},
+                          Integer{fraction, negative && integer == 0},
+                          Integer{DENOMINATOR.divisor()});
+        return result;
+    }
+
+    constexpr bool IsOverflowed() const noexcept {
+        return mValue.is_overflow();
+    }
+
+    constexpr bool IsNotANumber() const noexcept {
+        return mValue.is_nan();
+    }
+
+    constexpr bool IsZero() const noexcept {
+        return mValue.is_zero();
+    }
+
+    constexpr bool IsNegative() const noexcept {
+        return mValue.is_negative();
+    }
+
+    constexpr FixedDecimal Abs() const noexcept {
+        return FromScaled(mValue.abs());
+    }
+
+    constexpr FixedDecimal operator-() const noexcept {
+        return FromScaled(-mValue);
+    }
+
+    /**
+     * @brief Сложение: одно сложение 128-битных целых с проверкой переполнения.
+     */
+    FixedDecimal operator+(const FixedDecimal& other) const noexcept {
+        if (IsOverflowed() || other.IsOverflowed())
+            return FromScaled(Value::overflow());
+        if (IsNotANumber() || other.IsNotANumber())
+            return FixedDecimal{};
+        return Settle(mValue + other.mValue);
+    }
+
+    FixedDecimal operator-(const FixedDecimal& other) const noexcept {
+        return *this + (-other);
+    }
+
+    /**
+     * @brief Умножение: 256-битное произведение модулей и одно деление на константу 10^W;
+     * остаток округляется в режиме контекста.
+     */
+    FixedDecimal operator*(const FixedDecimal& other) const noexcept {
+        if (IsOverflowed() || other.IsOverflowed())
+            return FromScaled(Value::overflow());
+        if (IsNotANumber() || other.IsNotANumber())
+            return FixedDecimal{};
+        const bool negative = mValue.is_negative() != other.mValue.is_negative();
+        const auto& product = U256::mult_ext(mValue.unsigned_part(), other.mValue.unsigned_part());
+        if constexpr (W == 0) {
+            return FromMagnitude(product, negative);
+        } else {
+            const auto& [quotient, remainder] = product.divrem(DENOMINATOR);
+            return FromMagnitude(quotient, negative, rounding::Classify(remainder, DENOMINATOR.divisor()));
+        }
+    }
+
+    /**
+     * @brief Деление: 256-битное произведение делимого на 10^W и одно деление 256/128;
+     * остаток округляется в режиме контекста.
+     */
+    FixedDecimal operator/(const FixedDecimal& other) const noexcept {
+        if (other.IsZero())
+            return IsZero() ? FixedDecimal{} : FromScaled(Value::overflow());
+        if (IsOverflowed() || other.IsOverflowed())
+            return FromScaled(Value::overflow());
+        if (IsNotANumber() || other.IsNotANumber())
+            return FixedDecimal{};
+        const auto& numerator = U256::mult_ext(mValue.unsigned_part(), DENOMINATOR.divisor());
+        const U128 divisor = other.mValue.unsigned_part();
+        const auto& [quotient, remainder] = numerator.divrem(divisor);
+        const bool negative = mValue.is_negative() != other.mValue.is_negative();
+        return FromMagnitude(quotient, negative, rounding::Classify(remainder, divisor));
+    }
+
+private:
+    /**
+     * @brief Масштабированное значение x * 10^W; по умолчанию NaN.
+     */
+    Value mValue = Value::nan();
+
+    /**
+     * @brief Коррекция всех девяток, как в Decimal в режиме отбрасывания: дробная часть 0,99..9
+     * округляется до единицы. В остальных режимах значение уже округлено и не меняется.
+     */
+    static FixedDecimal Settle(const Value& value) noexcept {
+        if constexpr (W == 0)
+            return FromScaled(value);
+        if (value.is_singular() || Decimal::GetRounding() != RoundingMode::TRUNCATE)
+            return FromScaled(value);
+        const U128 magnitude = value.unsigned_part();
+        if (DENOMINATOR.remainder(magnitude) + U128{1} != DENOMINATOR.divisor())
+            return FromScaled(value);
+        return FromScaled(Value{magnitude + U128{1}, value.is_negative()});
+    }
+};
+
+/**
+ * @brief Запись числа в буфер [first, last) в формате Decimal: "inf", пустая строка для NaN
+ * или [-]целая часть[,W цифр].
+ * @return Указатель за последним записанным символом; value_too_large, если буфер мал.
+ */
+template <int W>
+inline std::to_chars_result to_chars(char* first, char* last, const FixedDecimal<W>& value) noexcept {
+    if (value.IsNotANumber())
+        return {first, std::errc{}};
+    if (value.IsOverflowed()) {
+        if (last - first < 3)
+            return {last, std::errc::value_too_large};
+        return {std::copy_n("inf", 3, first), std::errc{}};
+    }
+    U128 fraction;
+    const U128 integer = FixedDecimal<W>::DENOMINATOR.divide(value.Scaled().unsigned_part(), &fraction);
+    char* out = first;
+    if (value.IsNegative()) {
+        if (out == last)
+            return {last, std::errc::value_too_large};
+        *out++ = chars::minus_sign;
+    }
+    const auto [integer_end, ec] = bignum::u128::to_chars(out, last, integer);
+    if (ec != std::errc{})
+        return {last, ec};
+    out = integer_end;
+    if constexpr (W > 0) {
+        if (last - out < W + 1)
+            return {last, std::errc::value_too_large};
+        *out++ = chars::separator;
+        bignum::u128::write_digits_backward(out + W, fraction.low(), W);
+        out += W;
+    }
+    return {out, std::errc{}};
+}
+
+/**
+ * @brief Разбор записи [-]цифры[(,|.)цифры] из [first, last) в стиле std::from_chars, как у Decimal:
+ * лишние цифры после запятой округляются в режиме контекста, недостающие дополняются нулями.
+ * @return Указатель на первый неразобранный символ; invalid_argument, если цифр нет;
+ * result_out_of_range, если число вне диапазона FixedDecimal<W> (value при ошибках не меняется).
+ */
+template <int W>
+inline std::from_chars_result from_chars(const char* first, const char* last, FixedDecimal<W>& value) noexcept {
+    const char* p = first;
+    const bool negative = p != last && *p == chars::minus_sign;
+    if (negative)
+        ++p;
+    U128 integer;
+    const auto [integer_end, ec] = bignum::u128::from_chars(p, last, integer);
+    if (ec == std::errc::invalid_argument)
+        return {first, ec};
+    p = integer_end;
+    const auto is_digit = [](char c) { return c >= '0' && c <= '9'; };
+    u64 fraction = 0;
+    int fraction_digits = 0;
+    int first_dropped = -1; // Первая отброшенная цифра и признак ненулевых цифр за ней.
+    bool is_sticky = false;
+    if (last - p > 1 && (*p == chars::separator || *p == chars::alternative_separator) && is_digit(p[1])) {
+        for (++p; p != last && is_digit(*p); ++p) {
+            const int digit = *p - chars::zero;
+            if (fraction_digits < W) {
+                fraction = fraction * 10 + static_cast<u64>(digit);
+                ++fraction_digits;
+            } else if (first_dropped < 0) {
+                first_dropped = digit;
+            } else {
+                is_sticky |= digit != 0;
+            }
+        }
+    }
+    if (ec == std::errc::result_out_of_range)
+        return {p, ec};
+    fraction *= bignum::u128::pow10(W - fraction_digits).low();
+    using U256 = bignum::UBig<U128>;
+    const auto& magnitude = U256::mult_ext(integer, FixedDecimal<W>::DENOMINATOR.divisor()) + U256{U128{fraction}};
+    const auto remainder = first_dropped > 5 || (first_dropped == 5 && is_sticky) ? rounding::ABOVE_HALF
+                           : first_dropped == 5                                 ? rounding::HALF
+                           : first_dropped > 0 || is_sticky                     ? rounding::BELOW_HALF
+                                                                                : rounding::EXACT;
+    const auto& x = FixedDecimal<W>::FromMagnitude(magnitude, negative, remainder);
+    if (x.IsOverflowed())
+        return {p, std::errc::result_out_of_range};
+    value = x;
+    return {p, std::errc{}};
+}
+
+/**
+ * @brief Вызвать f(std::integral_constant<int, W>{}) для W, равного ширине width во время выполнения:
+ * мост от текущей ширины Decimal к FixedDecimal<W>.
+ */
+template <typename F>
+inline decltype(auto) WithWidth(int width, F&& f) {
+    return [&]<int... Ws>(std::integer_sequence<int, Ws...>) {
+        using Result = decltype(f(std::integral_constant<int, 0>{}));
+        Result result{};
+        static_cast<void>(((width == Ws ? (result = f(std::integral_constant<int, Ws>{}), true) : false) || ...));
+        return result;
+    }(std::make_integer_sequence<int, Decimal::MaxWidth() + 1>{});
+}
+
+/**
+ * @brief Делители 10^width с предвычисленными обратными величинами для всех допустимых ширин.
+ */
+inline constexpr auto POW10_DIVIDERS = []<int... Ws>(std::integer_sequence<int, Ws...>) {
+    return std::array<bignum::u128::Divider<U128>, sizeof...(Ws)>{FixedDecimal<Ws>::DENOMINATOR...};
+}(std::make_integer_sequence<int, Decimal::MaxWidth() + 1>{});
+
+/**
+ * @brief Число с фиксированной запятой при текущей ширине Decimal: тонкая обертка над FixedDecimal<W>,
+ * каждая операция которой выбирает W = Decimal::GetWidth() и выполняется с константным знаменателем.
+ * Значение привязано к ширине, при которой оно получено: после SetWidth числа нужно пересоздать.
+ */
+class ScaledDecimal {
+public:
+    using Value = bignum::s128::S128;
+
+    /**
+     * @brief Конструктор по умолчанию: NaN, как у Decimal.
+     */
+    constexpr ScaledDecimal() noexcept = default;
+
+    /**
+     * @brief Преобразование из Decimal при текущей ширине; вне диапазона - inf.
+     */
+    explicit ScaledDecimal(const Decimal& x) noexcept
+        : mValue{Dispatch([&](auto fixed) { return decltype(fixed){x}; }).mValue} {}
+
+    /**
+     * @brief Преобразование из числа фиксированной ширины; ширины должны совпадать.
+     */
+    template <int W>
+    explicit ScaledDecimal(const FixedDecimal<W>& x) noexcept : mValue{x.Scaled()} {
+        assert(W == Decimal::GetWidth());
+    }
+
+    /**
+     * @brief Число из готового масштабированного значения, value = x * 10^width.
+     */
+    static constexpr ScaledDecimal FromScaled(const Value& value) noexcept {
+        ScaledDecimal result;
+        result.mValue = value;
+        return result;
+    }
+
+    /**
+     * @brief Число из 256-битного модуля масштабированного значения и знака; см. FixedDecimal::FromMagnitude.
+     */
+    static ScaledDecimal FromMagnitude(const bignum::UBig<U128>& magnitude, bool negative) noexcept {
+        return Dispatch([&](auto fixed) { return decltype(fixed)::FromMagnitude(magnitude, negative); });
+    }
+
+    /**
+     * @brief Масштабированное значение x * 10^width.
+     */
+    constexpr const Value& Scaled() const noexcept {
+        return mValue;
+    }
+
+    /**
+     * @brief Преобразование в Decimal при текущей ширине (без потери точности).
+     */
+    Decimal ToDecimal() const {
+        return WithWidth(Decimal::GetWidth(), [this](auto width) {
+            return FixedDecimal<width>::FromScaled(mValue).ToDecimal();
+        });
+    }
+
+    constexpr bool IsOverflowed() const noexcept {
+        return mValue.is_overflow();
+    }
+
+    constexpr bool IsNotANumber() const noexcept {
+        return mValue.is_nan();
+    }
+
+    constexpr bool IsZero() const noexcept {
+        return mValue.is_zero();
+    }
+
+    constexpr bool IsNegative() const noexcept {
+        return mValue.is_negative();
+    }
+
+    constexpr ScaledDecimal Abs() const noexcept {
+        return FromScaled(mValue.abs());
+    }
+
+    constexpr ScaledDecimal operator-() const noexcept {
+        return FromScaled(-mValue);
+    }
+
+    ScaledDecimal operator+(const ScaledDecimal& other) const noexcept {
+        return Dispatch([&](auto fixed) { return As(fixed) + other.As(fixed); });
+    }
+
+    ScaledDecimal operator-(const ScaledDecimal& other) const noexcept {
+        return Dispatch([&](auto fixed) { return As(fixed) - other.As(fixed); });
+    }
+
+    ScaledDecimal operator*(const ScaledDecimal& other) const noexcept {
+        return Dispatch([&](auto fixed) { return As(fixed) * other.As(fixed); });
+    }
+
+    ScaledDecimal operator/(const ScaledDecimal& other) const noexcept {
+        return Dispatch([&](auto fixed) { return As(fixed) / other.As(fixed); });
+    }
+
+    /**
+     * @brief Делитель 10^width для текущей ширины.
+     */
+    static const bignum::u128::Divider<U128>& Denominator() noexcept {
+        return POW10_DIVIDERS[Decimal::GetWidth()];
+    }
+
+private:
+    /**
+     * @brief Масштабированное значение x * 10^width; по умолчанию NaN.
+     */
+    Value mValue = Value::nan();
+
+    /**
+     * @brief Это же значение как FixedDecimal той ширины, что и образец.
+     */
+    template <int W>
+    constexpr FixedDecimal<W> As(FixedDecimal<W>) const noexcept {
+        return FixedDecimal<W>::FromScaled(mValue);
+    }
+
+    /**
+     * @brief Выполнить f(FixedDecimal<W>{}) при W = Decimal::GetWidth() и обернуть результат.
+     */
+    template <typename F>
+    static ScaledDecimal Dispatch(F&& f) {
+        return WithWidth(Decimal::GetWidth(), [&](auto width) {
+            return FromScaled(f(FixedDecimal<width>{}).Scaled());
+        });
+    }
+};
+
+inline std::to_chars_result to_chars(char* first, char* last, const ScaledDecimal& value) noexcept {
+    return WithWidth(Decimal::GetWidth(), [&](auto width) {
+        return to_chars(first, last, FixedDecimal<width>::FromScaled(value.Scaled()));
+    });
+}
+
+inline std::from_chars_result from_chars(const char* first, const char* last, ScaledDecimal& value) noexcept {
+    return WithWidth(Decimal::GetWidth(), [&](auto width) {
+        FixedDecimal<width> x;
+        const auto result = from_chars(first, last, x);
+        if (result.ec == std::errc{})
+            value = ScaledDecimal{x};
+        return result;
+    });
+}
+
+}
@@ -11,10 +11,17 @@
 #include <string_view>
 #include <utility>
 #include <algorithm>
+#include <array>
 #include <bit>
+#include <charconv>
 #include <compare>
+#include <cstring>
 #include <type_traits>
 
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+
 #if defined(_MSC_VER) && (_MSC_VER >= 1920) && defined(_M_X64)
 #define USE_MSVC_INTRINSICS_DIVISION
 #define USE_MSVC_INTRINSICS
@@ -327,54 +334,240 @@ inline constexpr U128 &U128::operator>>=(u32 s) noexcept
     return *this;
 }
 
-// Низкоуровневое деление 128/64 для эмуляции
+/**
+ * @brief Начальное приближение обратной величины: floor((2^19 - 3 * 2^8) / d9),
+ * где d9 = 256...511 - старшие 9 бит нормализованного делителя.
+ */
+inline constexpr auto RECIPROCAL_TABLE = [] {
+    std::array<uint16_t, 256> t{};
+    for (u32 i = 0; i < 256; ++i)
+        t[i] = static_cast<uint16_t>(((1u << 19) - 3 * (1u << 8)) / (i + 256));
+    return t;
+}();
+
+/**
+ * @brief Обратная величина нормализованного (старший бит равен 1) делителя d:
+ * v = floor((2^128 - 1) / d) - 2^64.
+ * Вычисляется без деления: табличное приближение и три шага Ньютона.
+ * Möller N., Granlund T. Improved division by invariant integers, 2011 (алгоритм 3).
+ */
+inline constexpr u64 reciprocal_word(u64 d) noexcept
+{
+    const u64 d0 = d & 1;
+    const u64 d9 = d >> 55;
+    const u64 d40 = (d >> 24) + 1;
+    const u64 d63 = (d >> 1) + d0;
+    const u64 v0 = RECIPROCAL_TABLE[d9 - 256];
+    const u64 v1 = (v0 << 11) - ((v0 * v0 * d40) >> 40) - 1;
+    const u64 v2 = (v1 << 13) + ((v1 * ((1ull << 60) - v1 * d40)) >> 47);
+    const u64 e = ((v2 >> 1) & (0 - d0)) - v2 * d63;
+    const u64 v3 = (v2 << 31) + (U128::mult_ext(v2, e).high() >> 1);
+    const U128 p = U128::mult_ext(v3, d) + U128{d};
+    return v3 - p.high() - d;
+}
+
+/**
+ * @brief Деление 128/64 с предвычисленной обратной величиной (алгоритм 4 Мёллера-Гранлунда).
+ * @param u1 Старшая половина делимого, u1 < d.
+ * @param u0 Младшая половина делимого.
+ * @param d Нормализованный делитель.
+ * @param v Обратная величина reciprocal_word(d).
+ * @param r Остаток.
+ * @return Частное.
+ */
+inline constexpr u64 div_2by1(u64 u1, u64 u0, u64 d, u64 v, u64 &r) noexcept
+{
+    U128 q = U128::mult_ext(v, u1) + U128{u0, u1};
+    u64 q1 = q.high() + 1;
+    r = u0 - q1 * d;
+    // Условие непредсказуемо, поэтому коррекция без ветвления.
+    const u64 mask = 0 - static_cast<u64>(r > q.low());
+    q1 += mask;
+    r += mask & d;
+    if (r >= d) [[unlikely]]
+    {
+        ++q1;
+        r -= d;
+    }
+    return q1;
+}
+
+/**
+ * @brief Обратная величина нормализованного двухсловного делителя (d1, d0):
+ * v = floor((2^192 - 1) / (d1, d0)) - 2^64 (алгоритм 6 Мёллера-Гранлунда).
+ */
+inline constexpr u64 reciprocal_2words(u64 d1, u64 d0) noexcept
+{
+    u64 v = reciprocal_word(d1);
+    u64 p = d1 * v + d0;
+    if (p < d0)
+    {
+        --v;
+        if (p >= d1)
+        {
+            --v;
+            p -= d1;
+        }
+        p -= d1;
+    }
+    const U128 t = U128::mult_ext(v, d0);
+    p += t.high();
+    if (p < t.high())
+    {
+        --v;
+        if (U128{t.low(), p} >= U128{d0, d1})
+            --v;
+    }
+    return v;
+}
+
+/**
+ * @brief Деление 192/128 с предвычисленной обратной величиной (алгоритм 5 Мёллера-Гранлунда).
+ * @param u2, u1, u0 Делимое, (u2, u1) < (d1, d0).
+ * @param d Нормализованный делитель (d1, d0).
+ * @param v Обратная величина reciprocal_2words(d1, d0).
+ * @param r Остаток.
+ * @return Частное.
+ */
+inline constexpr u64 div_3by2(u64 u2, u64 u1, u64 u0, const U128 &d, u64 v, U128 &r) noexcept
+{
+    const U128 q = U128::mult_ext(v, u2) + U128{u1, u2};
+    u64 q1 = q.high();
+    const u64 r1 = u1 - q1 * d.high();
+    r = U128{u0, r1} - U128::mult_ext(d.low(), q1) - d;
+    const u64 mask = 0 - static_cast<u64>(r.high() >= q.low());
+    q1 += mask + 1;
+    r += d & U128{mask, mask};
+    if (r >= d) [[unlikely]]
+    {
+        ++q1;
+        r -= d;
+    }
+    return q1;
+}
+
+// Низкоуровневое деление 128/64 для эмуляции. Требуется h < d.
 inline constexpr u64 div_internal(u64 h, u64 l, u64 d, u64 *r) noexcept
 {
 #if defined(USE_MSVC_INTRINSICS)
     if (!std::is_constant_evaluated())
         return _udiv128(h, l, d, r);
 #endif
-    u64 rem = h;
-    u64 qh = ((rem << 32) | (l >> 32)) / d;
-    rem = ((rem << 32) | (l >> 32)) % d;
-    u64 ql = ((rem << 32) | (l & 0xFFFFFFFF)) / d;
+    const u32 s = std::countl_zero(d);
+    const u64 dn = d << s;
+    const u64 hn = (s == 0) ? h : (h << s) | (l >> (64 - s));
+    u64 rem;
+    const u64 q = div_2by1(hn, l << s, dn, reciprocal_word(dn), rem);
     if (r)
-        *r = ((rem << 32) | (l & 0xFFFFFFFF)) % d;
-    return (qh << 32) | ql;
+        *r = rem >> s;
+    return q;
 }
 
+template <typename T>
+class Divider;
+
+/**
+ * @brief Деление на инвариантный делитель: обратная величина вычисляется один раз в конструкторе,
+ * после чего каждое деление сводится к нескольким умножениям (в духе libdivide).
+ * Применяется там, где на одно и то же число делят многократно.
+ */
+template <>
+class Divider<U128>
+{
+public:
+    constexpr Divider() noexcept = default;
+
+    /**
+     * @brief Конструктор.
+     * @param d Делитель. Для нулевого делителя частное и остаток равны нулю, как в U128::divide.
+     */
+    constexpr explicit Divider(const U128 &d) noexcept : mDivisor{d}
+    {
+        if (d == 0)
+            return;
+        mShift = d.countl_zero() & 63;
+        mNormalized = d << mShift;
+        mReciprocal = d.high() == 0 ? reciprocal_word(mNormalized.low())
+                                    : reciprocal_2words(mNormalized.high(), mNormalized.low());
+    }
+
+    [[nodiscard]] constexpr const U128 &divisor() const noexcept { return mDivisor; }
+    [[nodiscard]] constexpr const U128 &normalized() const noexcept { return mNormalized; }
+    [[nodiscard]] constexpr u64 reciprocal() const noexcept { return mReciprocal; }
+    [[nodiscard]] constexpr u32 shift() const noexcept { return mShift; }
+
+    /**
+     * @brief Частное x / d.
+     * @param rem_out Остаток x % d (может быть nullptr).
+     */
+    constexpr U128 divide(const U128 &x, U128 *rem_out = nullptr) const noexcept
+    {
+        U128 q, r;
+        if (mDivisor == 0)
+        {
+            q = r = 0;
+        }
+        else if (x < mDivisor)
+        {
+            q = 0;
+            r = x;
+        }
+        else
+        {
+            // Нормализация: делимое сдвигается вместе с делителем, вытолкнутые биты - в третье слово.
+            const u64 top = (mShift == 0) ? 0 : x.high() >> (64 - mShift);
+            const U128 xn = x << mShift;
+            if (mDivisor.high() == 0)
+            {
+                const u64 d = mNormalized.low();
+                u64 rem;
+                const u64 q1 = div_2by1(top, xn.high(), d, mReciprocal, rem);
+                const u64 q0 = div_2by1(rem, xn.low(), d, mReciprocal, rem);
+                q = U128{q0, q1};
+                r = U128{rem >> mShift};
+            }
+            else
+            {
+                q = U128{div_3by2(top, xn.high(), xn.low(), mNormalized, mReciprocal, r)};
+                r >>= mShift;
+            }
+        }
+        if (rem_out)
+            *rem_out = r;
+        return q;
+    }
+
+    /**
+     * @brief Остаток x % d.
+     */
+    constexpr U128 remainder(const U128 &x) const noexcept
+    {
+        U128 r;
+        divide(x, &r);
+        return r;
+    }
+
+private:
+    U128 mDivisor{0};
+    U128 mNormalized{0};
+    u64 mReciprocal = 0;
+    u32 mShift = 0;
+};
+
+inline constexpr U128 operator/(const U128 &x, const Divider<U128> &d) noexcept { return d.divide(x); }
+inline constexpr U128 operator%(const U128 &x, const Divider<U128> &d) noexcept { return d.remainder(x); }
+
 template <bool Q, bool R>
 inline constexpr U128 U128::divide_manual(const U128 &dividend, const U128 &divisor, U128 *rem_out) noexcept
 {
     if (divisor == U128(0))
         return {0, 0};
-    if (divisor.mHigh == 0)
-    {
-        u64 r0, r1, q1 = div_internal(0, dividend.mHigh, divisor.mLow, &r0), q0 = div_internal(r0, dividend.mLow, divisor.mLow, &r1);
-        if constexpr (R)
-            if (rem_out)
-                *rem_out = {r1, 0};
-        return Q ? U128(q0, q1) : U128(0);
-    }
-    u32 s = std::countl_zero(divisor.mHigh);
-    U128 v = divisor << s, u = dividend;
-    u64 h_in = (s == 0) ? 0 : (u.mHigh >> (64 - s)), rt;
-    u64 qe = div_internal(h_in, (u << s).mHigh, v.mHigh, &rt);
-    U128 qr{qe, 0}, prod = qr * divisor;
-    while (prod > dividend)
-    {
-        prod -= divisor;
-        qr.mLow--;
-    }
-    while ((dividend - prod) >= divisor)
-    {
-        prod += divisor;
-        qr.mLow++;
-    }
+    U128 rem;
+    const U128 q = Divider<U128>{divisor}.divide(dividend, &rem);
     if constexpr (R)
         if (rem_out)
-            *rem_out = dividend - prod;
-    return Q ? qr : U128(0);
+            *rem_out = rem;
+    return Q ? q : U128(0);
 }
 
 template <bool Q, bool R>
@@ -422,47 +615,242 @@ inline constexpr U128 U128::fromString(std::string_view s)
     return res;
 }
 
-inline std::string U128::toString() const
+/**
+ * @brief Делитель 10^19 - наибольшая степень десяти, помещающаяся в 64 бита.
+ * Число U128 содержит не более трех таких блоков: 2^128 < 10^39.
+ */
+inline constexpr Divider<U128> TEN_POW_19{10000000000000000000ULL};
+
+/**
+ * @brief Пары десятичных цифр "00", "01", ..., "99": вывод по две цифры за шаг.
+ */
+inline constexpr auto DIGIT_PAIRS = [] {
+    std::array<char, 200> t{};
+    for (int i = 0; i < 100; ++i)
+    {
+        t[2 * i] = static_cast<char>('0' + i / 10);
+        t[2 * i + 1] = static_cast<char>('0' + i % 10);
+    }
+    return t;
+}();
+
+/**
+ * @brief Степени десяти 10^0, ..., 10^38: все, что помещаются в 128 бит.
+ */
+inline constexpr auto POWERS_OF_TEN = [] {
+    std::array<U128, 39> t{};
+    U128 p{1};
+    for (auto &x : t)
+    {
+        x = p;
+        p = p * U128{10};
+    }
+    return t;
+}();
+
+/**
+ * @brief Степень десяти 10^n табличным поиском, n <= 38.
+ */
+inline constexpr U128 pow10(unsigned n) noexcept
+{
+    assert(n < POWERS_OF_TEN.size());
+    return POWERS_OF_TEN[n];
+}
+
+/**
+ * @brief Количество десятичных цифр числа (для нуля - одна) без делений.
+ * Оценка по числу битов: log10(2) ~ 1233 / 4096, затем одно сравнение со степенью десяти.
+ */
+inline constexpr int digits10(const U128 &x) noexcept
 {
-    if (!(*this))
-        return "0";
+    const int t = static_cast<int>(x.bit_width() * 1233) >> 12;
+    return t + (x >= POWERS_OF_TEN[t] ? 1 : 0) + (x == 0 ? 1 : 0);
+}
+
+inline constexpr int digits10(u64 x) noexcept
+{
+    const int t = (static_cast<int>(std::bit_width(x)) * 1233) >> 12;
+    return t + (x >= POWERS_OF_TEN[t].low() ? 1 : 0) + (x == 0 ? 1 : 0);
+}
 
-    U128 copy = *this;
-    std::string s;
-    s.reserve(40); // Оптимизация аллокаций
+/**
+ * @brief Целая часть десятичного логарифма, floor(log10(x)); для нуля -1.
+ */
+inline constexpr int floor_log10(const U128 &x) noexcept
+{
+    return x == 0 ? -1 : digits10(x) - 1;
+}
 
-    while (copy > 0)
+/**
+ * @brief Записать ровно n младших десятичных цифр числа v (с ведущими нулями),
+ * заканчивая перед позицией end.
+ */
+inline constexpr void write_digits_backward(char *end, u64 v, int n) noexcept
+{
+    for (; n >= 2; n -= 2)
     {
-        U128 next_q, rem_u;
-        // Делим на 10^19
-        next_q = divide<true, true>(copy, 10000000000000000000ULL, &rem_u);
-        uint64_t r = rem_u.low();
+        const auto i = 2 * (v % 100);
+        v /= 100;
+        end -= 2;
+        end[0] = DIGIT_PAIRS[i];
+        end[1] = DIGIT_PAIRS[i + 1];
+    }
+    if (n > 0)
+        *--end = static_cast<char>('0' + v % 10);
+}
+
+/**
+ * @brief Десятичная запись числа в буфер [first, last) в стиле std::to_chars.
+ * Число делится на блоки по 19 цифр, блоки выводятся парами цифр. Память не выделяется.
+ * @return Указатель за последним записанным символом; value_too_large, если буфер мал.
+ */
+inline constexpr std::to_chars_result to_chars(char *first, char *last, const U128 &value) noexcept
+{
+    u64 chunks[2]{};
+    int count = 0;
+    U128 v = value;
+    while (v.high() != 0 || v.low() >= TEN_POW_19.divisor().low())
+    {
+        U128 r;
+        v = TEN_POW_19.divide(v, &r);
+        chunks[count++] = r.low();
+    }
+    const int top_length = digits10(v.low());
+    const int length = top_length + 19 * count;
+    if (last - first < length)
+        return {last, std::errc::value_too_large};
+    write_digits_backward(first + top_length, v.low(), top_length);
+    char *out = first + top_length;
+    for (int i = count - 1; i >= 0; --i)
+    {
+        out += 19;
+        write_digits_backward(out, chunks[i], 19);
+    }
+    return {out, std::errc{}};
+}
+
+/**
+ * @brief Являются ли все восемь байтов слова (прочитанного в little-endian) ASCII-цифрами.
+ */
+inline constexpr bool is_eight_digits(u64 v) noexcept
+{
+    return ((v & 0xF0F0F0F0F0F0F0F0ull) | (((v + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) ==
+           0x3333333333333333ull;
+}
+
+/**
+ * @brief Значение восьми ASCII-цифр, упакованных в слово (little-endian), без цикла по цифрам (SWAR).
+ */
+inline constexpr u64 parse_eight_digits(u64 v) noexcept
+{
+    v -= 0x3030303030303030ull;
+    v = (v * 10) + (v >> 8); // Пары цифр.
+    return (((v & 0x000000FF000000FFull) * (100 + (1000000ull << 32))) +
+            (((v >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32)))) >> 32;
+}
+
+#if defined(__SSE4_2__)
+/**
+ * @brief Количество ASCII-цифр в начале 16-байтового блока (SSE4.2, PCMPESTRI).
+ */
+inline int count_leading_digits16(__m128i chunk) noexcept
+{
+    const __m128i range = _mm_setr_epi8('0', '9', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    return _mm_cmpestri(range, 2, chunk, 16, _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_NEGATIVE_POLARITY);
+}
 
-        copy = next_q;
+/**
+ * @brief Значение шестнадцати ASCII-цифр блока: попарные умножения-сложения до двух 8-значных половин.
+ */
+inline u64 parse_sixteen_digits(__m128i chunk) noexcept
+{
+    __m128i v = _mm_sub_epi8(chunk, _mm_set1_epi8('0'));
+    v = _mm_maddubs_epi16(v, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+    v = _mm_madd_epi16(v, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+    v = _mm_packus_epi32(v, v);
+    v = _mm_madd_epi16(v, _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+    const u64 high = static_cast<uint32_t>(_mm_cvtsi128_si32(v));
+    const u64 low = static_cast<uint32_t>(_mm_extract_epi32(v, 1));
+    return high * 100000000ull + low;
+}
+#endif
 
-        // Если это не последний блок (есть еще цифры выше),
-        // мы ОБЯЗАНЫ записать все 19 разрядов, включая нули.
-        if (copy > 0)
+/**
+ * @brief Разбор десятичной записи из [first, last) в стиле std::from_chars.
+ * Цифры накапливаются блоками: по 16 за раз (SSE4.2), по 8 (SWAR) или поштучно в хвосте;
+ * переполнение проверяется один раз на блок.
+ * @return Указатель на первый неразобранный символ; invalid_argument, если цифр нет;
+ * result_out_of_range, если число не помещается в 128 бит (value при ошибках не меняется).
+ */
+inline constexpr std::from_chars_result from_chars(const char *first, const char *last, U128 &value) noexcept
+{
+    constexpr bool swar = std::endian::native == std::endian::little;
+    const auto is_digit = [](char c) { return c >= '0' && c <= '9'; };
+    const char *p = first;
+    U128 result{0};
+    bool overflow = false;
+    while (p != last && is_digit(*p))
+    {
+        u64 block = 0, scale = 1;
+        if (!std::is_constant_evaluated() && swar)
         {
-            for (int i = 0; i < 19; ++i)
+#if defined(__SSE4_2__)
+            if (last - p >= 16)
             {
-                s += (char)('0' + (r % 10));
-                r /= 10;
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+                if (count_leading_digits16(chunk) == 16)
+                {
+                    block = parse_sixteen_digits(chunk);
+                    scale = 10000000000000000ull;
+                    p += 16;
+                }
+            }
+#endif
+            if (scale == 1 && last - p >= 8)
+            {
+                u64 word;
+                std::memcpy(&word, p, sizeof(word));
+                if (is_eight_digits(word))
+                {
+                    block = parse_eight_digits(word);
+                    scale = 100000000ull;
+                    p += 8;
+                }
             }
         }
-        else
+        if (scale == 1)
         {
-            // Если это самый старший блок, пишем только значащие цифры
-            do
+            // Хвост короче блока или с посторонним символом: поштучно, не более 19 цифр.
+            const char *end = (last - p > 19) ? p + 19 : last;
+            for (; p != end && is_digit(*p); ++p)
             {
-                s += (char)('0' + (r % 10));
-                r /= 10;
-            } while (r > 0);
+                block = block * 10 + static_cast<u64>(*p - '0');
+                scale *= 10;
+            }
         }
-    }
+        if (overflow)
+            continue;
+        // result = result * scale + block с контролем переполнения.
+        const U128 low = U128::mult_ext(result.low(), scale);
+        const U128 high = U128::mult_ext(result.high(), scale);
+        const U128 shifted = low + U128{0, high.low()};
+        const U128 next = shifted + U128{block};
+        overflow = high.high() != 0 || shifted.high() < low.high() || next < shifted;
+        result = next;
+    }
+    if (p == first)
+        return {first, std::errc::invalid_argument};
+    if (overflow)
+        return {p, std::errc::result_out_of_range};
+    value = result;
+    return {p, std::errc{}};
+}
 
-    std::reverse(s.begin(), s.end());
-    return s;
+inline std::string U128::toString() const
+{
+    char buffer[39];
+    const auto [end, ec] = to_chars(std::begin(buffer), std::end(buffer), *this);
+    return std::string(buffer, end);
 }
 
 inline constexpr U128 operator""_u128(const char *str, std::size_t len) { return U128::fromString({str, len}); }
@@ -0,0 +1,481 @@
+#include "u128_array.h"
+
+#include <cassert>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define USE_AVX2_KERNELS
+#define AVX2_TARGET __attribute__((target("avx2")))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define USE_AVX2_KERNELS
+#define AVX2_TARGET
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace bignum::u128
+{
+
+namespace {
+
+// --- Скалярные ядра: работают везде и дорабатывают хвост после векторной части ---
+
+void add_scalar(u64 *lo, u64 *hi, const u64 *blo, const u64 *bhi, std::size_t from, std::size_t n) noexcept
+{
+    for (std::size_t i = from; i < n; ++i)
+    {
+        const u64 l = lo[i] + blo[i];
+        hi[i] += bhi[i] + (l < lo[i] ? 1 : 0);
+        lo[i] = l;
+    }
+}
+
+void sub_scalar(u64 *lo, u64 *hi, const u64 *blo, const u64 *bhi, std::size_t from, std::size_t n) noexcept
+{
+    for (std::size_t i = from; i < n; ++i)
+    {
+        const u64 borrow = lo[i] < blo[i] ? 1 : 0;
+        lo[i] -= blo[i];
+        hi[i] -= bhi[i] + borrow;
+    }
+}
+
+void mul_scalar(u64 *lo, u64 *hi, u64 m, std::size_t from, std::size_t n) noexcept
+{
+    for (std::size_t i = from; i < n; ++i)
+    {
+        const U128 p = U128::mult_ext(lo[i], m);
+        lo[i] = p.low();
+        hi[i] = p.high() + hi[i] * m;
+    }
+}
+
+void shl_scalar(u64 *lo, u64 *hi, u32 s, std::size_t from, std::size_t n) noexcept
+{
+    for (std::size_t i = from; i < n; ++i)
+    {
+        const U128 x = U128{lo[i], hi[i]} << s;
+        lo[i] = x.low();
+        hi[i] = x.high();
+    }
+}
+
+void shr_scalar(u64 *lo, u64 *hi, u32 s, std::size_t from, std::size_t n) noexcept
+{
+    for (std::size_t i = from; i < n; ++i)
+    {
+        const U128 x = U128{lo[i], hi[i]} >> s;
+        lo[i] = x.low();
+        hi[i] = x.high();
+    }
+}
+
+void select_scalar(u64 *lo, u64 *hi, const u64 *blo, const u64 *bhi, bool take_less, std::size_t from, std::size_t n) noexcept
+{
+    for (std::size_t i = from; i < n; ++i)
+    {
+        const bool other_less = U128{blo[i], bhi[i]} < U128{lo[i], hi[i]};
+        if (other_less == take_less)
+        {
+            lo[i] = blo[i];
+            hi[i] = bhi[i];
+        }
+    }
+}
+
+void less_scalar(const u64 *lo, const u64 *hi, const u64 *blo, const u64 *bhi, uint8_t *out, std::size_t from, std::size_t n) noexcept
+{
+    for (std::size_t i = from; i < n; ++i)
+        out[i] = U128{lo[i], hi[i]} < U128{blo[i], bhi[i]} ? 1 : 0;
+}
+
+/**
+ * @brief Накопитель суммы: 192 бита на поток, чего хватает на 2^64 слагаемых.
+ */
+struct Accumulator
+{
+    u64 lo = 0;
+    u64 hi = 0;
+    u64 top = 0;
+
+    void add(u64 l, u64 h) noexcept
+    {
+        lo += l;
+        const u64 c = lo < l ? 1 : 0;
+        const u64 h1 = hi + h;
+        top += (h1 < h ? 1 : 0);
+        hi = h1 + c;
+        top += (hi < c ? 1 : 0);
+    }
+};
+
+UBig<U128> to_ubig(const Accumulator &a) noexcept
+{
+    return UBig<U128>{U128{a.lo, a.hi}, U128{a.top}};
+}
+
+#if defined(USE_AVX2_KERNELS)
+
+constexpr std::size_t LANES = 4;
+
+/**
+ * @brief Беззнаковое сравнение a < b: в AVX2 есть только знаковое, поэтому инвертируем старший бит.
+ */
+AVX2_TARGET inline __m256i less_u64(__m256i a, __m256i b) noexcept
+{
+    const __m256i sign = _mm256_set1_epi64x(static_cast<long long>(1ull << 63));
+    return _mm256_cmpgt_epi64(_mm256_xor_si256(b, sign), _mm256_xor_si256(a, sign));
+}
+
+/**
+ * @brief Маска a < b для 128-битных чисел (a_hi, a_lo) и (b_hi, b_lo).
+ */
+AVX2_TARGET inline __m256i less_u128(__m256i alo, __m256i ahi, __m256i blo, __m256i bhi) noexcept
+{
+    const __m256i hi_lt = less_u64(ahi, bhi);
+    const __m256i hi_eq = _mm256_cmpeq_epi64(ahi, bhi);
+    return _mm256_or_si256(hi_lt, _mm256_and_si256(hi_eq, less_u64(alo, blo)));
+}
+
+AVX2_TARGET inline __m256i load(const u64 *p) noexcept
+{
+    return _mm256_load_si256(reinterpret_cast<const __m256i *>(p));
+}
+
+AVX2_TARGET inline void store(u64 *p, __m256i v) noexcept
+{
+    _mm256_store_si256(reinterpret_cast<__m256i *>(p), v);
+}
+
+AVX2_TARGET std::size_t add_avx2(u64 *lo, u64 *hi, const u64 *blo, const u64 *bhi, std::size_t n) noexcept
+{
+    std::size_t i = 0;
+    for (; i + LANES <= n; i += LANES)
+    {
+        const __m256i a = load(lo + i);
+        const __m256i l = _mm256_add_epi64(a, load(blo + i));
+        // Маска переноса равна -1, поэтому вычитается.
+        const __m256i carry = less_u64(l, a);
+        const __m256i h = _mm256_sub_epi64(_mm256_add_epi64(load(hi + i), load(bhi + i)), carry);
+        store(lo + i, l);
+        store(hi + i, h);
+    }
+    return i;
+}
+
+AVX2_TARGET std::size_t sub_avx2(u64 *lo, u64 *hi, const u64 *blo, const u64 *bhi, std::size_t n) noexcept
+{
+    std::size_t i = 0;
+    for (; i + LANES <= n; i += LANES)
+    {
+        const __m256i a = load(lo + i);
+        const __m256i b = load(blo + i);
+        const __m256i borrow = less_u64(a, b);
+        const __m256i h = _mm256_add_epi64(_mm256_sub_epi64(load(hi + i), load(bhi + i)), borrow);
+        store(lo + i, _mm256_sub_epi64(a, b));
+        store(hi + i, h);
+    }
+    return i;
+}
+
+AVX2_TARGET std::size_t mul_avx2(u64 *lo, u64 *hi, u64 m, std::size_t n) noexcept
+{
+    // Умножение 64x64 собирается из 32-битных произведений (vpmuludq).
+    const __m256i b0 = _mm256_set1_epi64x(static_cast<long long>(m & 0xFFFFFFFFu));
+    const __m256i b1 = _mm256_set1_epi64x(static_cast<long long>(m >> 32));
+    const __m256i mask32 = _mm256_set1_epi64x(0xFFFFFFFFll);
+    std::size_t i = 0;
+    for (; i + LANES <= n; i += LANES)
+    {
+        const __m256i a = load(lo + i);
+        const __m256i a1 = _mm256_srli_epi64(a, 32);
+        const __m256i p00 = _mm256_mul_epu32(a, b0);
+        const __m256i p01 = _mm256_mul_epu32(a, b1);
+        const __m256i p10 = _mm256_mul_epu32(a1, b0);
+        const __m256i p11 = _mm256_mul_epu32(a1, b1);
+        const __m256i mid = _mm256_add_epi64(_mm256_add_epi64(_mm256_srli_epi64(p00, 32), _mm256_and_si256(p01, mask32)),
+                                             _mm256_and_si256(p10, mask32));
+        const __m256i l = _mm256_or_si256(_mm256_and_si256(p00, mask32), _mm256_slli_epi64(mid, 32));
+        __m256i h = _mm256_add_epi64(p11, _mm256_srli_epi64(mid, 32));
+        h = _mm256_add_epi64(h, _mm256_add_epi64(_mm256_srli_epi64(p01, 32), _mm256_srli_epi64(p10, 32)));
+        // Младшие 64 бита произведения старшей половины на m.
+        const __m256i x = load(hi + i);
+        const __m256i x1 = _mm256_srli_epi64(x, 32);
+        const __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(x1, b0), _mm256_mul_epu32(x, b1));
+        const __m256i hx = _mm256_add_epi64(_mm256_mul_epu32(x, b0), _mm256_slli_epi64(cross, 32));
+        store(lo + i, l);
+        store(hi + i, _mm256_add_epi64(h, hx));
+    }
+    return i;
+}
+
+AVX2_TARGET std::size_t shl_avx2(u64 *lo, u64 *hi, u32 s, std::size_t n) noexcept
+{
+    // Сдвиги vpsllq/vpsrlq на 64 и более бит дают ноль, что избавляет от ветвления при s = 0.
+    const __m128i cnt = _mm_cvtsi32_si128(static_cast<int>(s < 64 ? s : s - 64));
+    const __m128i rcnt = _mm_cvtsi32_si128(static_cast<int>(64 - (s < 64 ? s : 0)));
+    std::size_t i = 0;
+    for (; i + LANES <= n; i += LANES)
+    {
+        const __m256i l = load(lo + i);
+        if (s < 64)
+        {
+            store(hi + i, _mm256_or_si256(_mm256_sll_epi64(load(hi + i), cnt), _mm256_srl_epi64(l, rcnt)));
+            store(lo + i, _mm256_sll_epi64(l, cnt));
+        }
+        else
+        {
+            store(hi + i, _mm256_sll_epi64(l, cnt));
+            store(lo + i, _mm256_setzero_si256());
+        }
+    }
+    return i;
+}
+
+AVX2_TARGET std::size_t shr_avx2(u64 *lo, u64 *hi, u32 s, std::size_t n) noexcept
+{
+    const __m128i cnt = _mm_cvtsi32_si128(static_cast<int>(s < 64 ? s : s - 64));
+    const __m128i lcnt = _mm_cvtsi32_si128(static_cast<int>(64 - (s < 64 ? s : 0)));
+    std::size_t i = 0;
+    for (; i + LANES <= n; i += LANES)
+    {
+        const __m256i h = load(hi + i);
+        if (s < 64)
+        {
+            store(lo + i, _mm256_or_si256(_mm256_srl_epi64(load(lo + i), cnt), _mm256_sll_epi64(h, lcnt)));
+            store(hi + i, _mm256_srl_epi64(h, cnt));
+        }
+        else
+        {
+            store(lo + i, _mm256_srl_epi64(h, cnt));
+            store(hi + i, _mm256_setzero_si256());
+        }
+    }
+    return i;
+}
+
+AVX2_TARGET std::size_t select_avx2(u64 *lo, u64 *hi, const u64 *blo, const u64 *bhi, bool take_less, std::size_t n) noexcept
+{
+    const __m256i flip = take_less ? _mm256_setzero_si256() : _mm256_set1_epi64x(-1);
+    std::size_t i = 0;
+    for (; i + LANES <= n; i += LANES)
+    {
+        const __m256i alo = load(lo + i), ahi = load(hi + i);
+        const __m256i olo = load(blo + i), ohi = load(bhi + i);
+        // Для максимума берем другой элемент, если он не меньше; равные элементы неразличимы.
+        const __m256i take_other = _mm256_xor_si256(less_u128(olo, ohi, alo, ahi), flip);
+        store(lo + i, _mm256_blendv_epi8(alo, olo, take_other));
+        store(hi + i, _mm256_blendv_epi8(ahi, ohi, take_other));
+    }
+    return i;
+}
+
+AVX2_TARGET std::size_t less_avx2(const u64 *lo, const u64 *hi, const u64 *blo, const u64 *bhi, uint8_t *out, std::size_t n) noexcept
+{
+    std::size_t i = 0;
+    for (; i + LANES <= n; i += LANES)
+    {
+        const __m256i lt = less_u128(load(lo + i), load(hi + i), load(blo + i), load(bhi + i));
+        const int bits = _mm256_movemask_pd(_mm256_castsi256_pd(lt));
+        for (std::size_t k = 0; k < LANES; ++k)
+            out[i + k] = static_cast<uint8_t>((bits >> k) & 1);
+    }
+    return i;
+}
+
+AVX2_TARGET std::size_t sum_avx2(const u64 *lo, const u64 *hi, std::size_t n, Accumulator &acc) noexcept
+{
+    __m256i slo = _mm256_setzero_si256();
+    __m256i shi = _mm256_setzero_si256();
+    __m256i stop = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + LANES <= n; i += LANES)
+    {
+        const __m256i l = load(lo + i);
+        const __m256i h = load(hi + i);
+        slo = _mm256_add_epi64(slo, l);
+        const __m256i c = less_u64(slo, l);
+        const __m256i h1 = _mm256_add_epi64(shi, h);
+        stop = _mm256_sub_epi64(stop, less_u64(h1, h));
+        shi = _mm256_sub_epi64(h1, c);
+        // Перенос из младшего слова переполняет старшее, только если оно стало нулем.
+        stop = _mm256_sub_epi64(stop, _mm256_and_si256(c, _mm256_cmpeq_epi64(shi, _mm256_setzero_si256())));
+    }
+    alignas(32) u64 vlo[LANES], vhi[LANES], vtop[LANES];
+    store(vlo, slo);
+    store(vhi, shi);
+    store(vtop, stop);
+    for (std::size_t k = 0; k < LANES; ++k)
+    {
+        acc.add(vlo[k], vhi[k]);
+        acc.top += vtop[k];
+    }
+    return i;
+}
+
+bool cpu_has_avx2() noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int regs[4];
+    __cpuid(regs, 0);
+    if (regs[0] < 7)
+        return false;
+    __cpuid(regs, 1);
+    // OSXSAVE и сохранение состояния YMM операционной системой.
+    if (!(regs[2] & (1 << 27)) || (_xgetbv(0) & 6) != 6)
+        return false;
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+const bool HAS_AVX2 = cpu_has_avx2();
+
+#endif
+
+}
+
+U128Array::U128Array(std::size_t n) : mLow(n), mHigh(n) {}
+
+U128Array::U128Array(std::span<const U128> values)
+{
+    assign(values);
+}
+
+void U128Array::resize(std::size_t n)
+{
+    mLow.resize(n);
+    mHigh.resize(n);
+}
+
+void U128Array::assign(std::span<const U128> values)
+{
+    resize(values.size());
+    for (std::size_t i = 0; i < values.size(); ++i)
+        set(i, values[i]);
+}
+
+void U128Array::copy_to(std::span<U128> out) const noexcept
+{
+    assert(out.size() == size());
+    for (std::size_t i = 0; i < out.size(); ++i)
+        out[i] = (*this)[i];
+}
+
+bool U128Array::simd_enabled() noexcept
+{
+#if defined(USE_AVX2_KERNELS)
+    return HAS_AVX2;
+#else
+    return false;
+#endif
+}
+
+U128Array &U128Array::operator+=(const U128Array &other) noexcept
+{
+    assert(other.size() == size());
+    std::size_t done = 0;
+#if defined(USE_AVX2_KERNELS)
+    if (HAS_AVX2)
+        done = add_avx2(mLow.data(), mHigh.data(), other.mLow.data(), other.mHigh.data(), size());
+#endif
+    add_scalar(mLow.data(), mHigh.data(), other.mLow.data(), other.mHigh.data(), done, size());
+    return *this;
+}
+
+U128Array &U128Array::operator-=(const U128Array &other) noexcept
+{
+    assert(other.size() == size());
+    std::size_t done = 0;
+#if defined(USE_AVX2_KERNELS)
+    if (HAS_AVX2)
+        done = sub_avx2(mLow.data(), mHigh.data(), other.mLow.data(), other.mHigh.data(), size());
+#endif
+    sub_scalar(mLow.data(), mHigh.data(), other.mLow.data(), other.mHigh.data(), done, size());
+    return *this;
+}
+
+U128Array &U128Array::operator*=(u64 m) noexcept
+{
+    std::size_t done = 0;
+#if defined(USE_AVX2_KERNELS)
+    if (HAS_AVX2)
+        done = mul_avx2(mLow.data(), mHigh.data(), m, size());
+#endif
+    mul_scalar(mLow.data(), mHigh.data(), m, done, size());
+    return *this;
+}
+
+U128Array &U128Array::operator<<=(u32 s) noexcept
+{
+    assert(s < 128);
+    std::size_t done = 0;
+#if defined(USE_AVX2_KERNELS)
+    if (HAS_AVX2)
+        done = shl_avx2(mLow.data(), mHigh.data(), s, size());
+#endif
+    shl_scalar(mLow.data(), mHigh.data(), s, done, size());
+    return *this;
+}
+
+U128Array &U128Array::operator>>=(u32 s) noexcept
+{
+    assert(s < 128);
+    std::size_t done = 0;
+#if defined(USE_AVX2_KERNELS)
+    if (HAS_AVX2)
+        done = shr_avx2(mLow.data(), mHigh.data(), s, size());
+#endif
+    shr_scalar(mLow.data(), mHigh.data(), s, done, size());
+    return *this;
+}
+
+void U128Array::min_with(const U128Array &other) noexcept
+{
+    assert(other.size() == size());
+    std::size_t done = 0;
+#if defined(USE_AVX2_KERNELS)
+    if (HAS_AVX2)
+        done = select_avx2(mLow.data(), mHigh.data(), other.mLow.data(), other.mHigh.data(), true, size());
+#endif
+    select_scalar(mLow.data(), mHigh.data(), other.mLow.data(), other.mHigh.data(), true, done, size());
+}
+
+void U128Array::max_with(const U128Array &other) noexcept
+{
+    assert(other.size() == size());
+    std::size_t done = 0;
+#if defined(USE_AVX2_KERNELS)
+    if (HAS_AVX2)
+        done = select_avx2(mLow.data(), mHigh.data(), other.mLow.data(), other.mHigh.data(), false, size());
+#endif
+    select_scalar(mLow.data(), mHigh.data(), other.mLow.data(), other.mHigh.data(), false, done, size());
+}
+
+void U128Array::less(const U128Array &other, std::span<uint8_t> out) const noexcept
+{
+    assert(other.size() == size() && out.size() == size());
+    std::size_t done = 0;
+#if defined(USE_AVX2_KERNELS)
+    if (HAS_AVX2)
+        done = less_avx2(mLow.data(), mHigh.data(), other.mLow.data(), other.mHigh.data(), out.data(), size());
+#endif
+    less_scalar(mLow.data(), mHigh.data(), other.mLow.data(), other.mHigh.data(), out.data(), done, size());
+}
+
+UBig<U128> U128Array::sum() const noexcept
+{
+    Accumulator acc;
+    std::size_t done = 0;
+#if defined(USE_AVX2_KERNELS)
+    if (HAS_AVX2)
+        done = sum_avx2(mLow.data(), mHigh.data(), size(), acc);
+#endif
+    for (std::size_t i = done; i < size(); ++i)
+        acc.add(mLow[i], mHigh[i]);
+    return to_ubig(acc);
+}
+
+}
@@ -0,0 +1,153 @@
+/**
+ * @brief Массив 128-битных чисел в раздельном (SoA) хранении с пакетными операциями.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <vector>
+
+#include "calculus_global.h"
+#include "u128.hpp"
+#include "ubig.hpp"
+
+namespace bignum::u128
+{
+
+/**
+ * @brief Аллокатор с заданным выравниванием (для загрузки векторных регистров без пересечения строк кэша).
+ */
+template <typename T, std::size_t Align>
+struct AlignedAllocator
+{
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Align>;
+    };
+
+    constexpr AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    constexpr AlignedAllocator(const AlignedAllocator<U, Align> &) noexcept {}
+
+    [[nodiscard]] T *allocate(std::size_t n)
+    {
+        return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t{Align}));
+    }
+
+    void deallocate(T *p, std::size_t) noexcept
+    {
+        ::operator delete(p, std::align_val_t{Align});
+    }
+
+    template <typename U>
+    constexpr bool operator==(const AlignedAllocator<U, Align> &) const noexcept { return true; }
+};
+
+/**
+ * @brief Массив чисел U128, где младшие и старшие половины лежат в двух отдельных
+ * выровненных на 32 байта массивах (structure of arrays).
+ * Такая раскладка позволяет обрабатывать по четыре числа за команду AVX2: поэлементные
+ * сложение и вычитание с переносом, сравнение, min/max, сдвиги и умножение на 64-битное число.
+ * Ядра AVX2 выбираются по CPUID во время выполнения; на прочих процессорах работает скалярный код.
+ * Арифметика поэлементная, по модулю 2^128, как у U128.
+ */
+class CALCULUS_EXPORT U128Array
+{
+public:
+    using Lane = std::vector<u64, AlignedAllocator<u64, 32>>;
+
+    U128Array() = default;
+
+    /**
+     * @brief Массив из n нулей.
+     */
+    explicit U128Array(std::size_t n);
+
+    /**
+     * @brief Копия последовательности чисел (раскладка AoS -> SoA).
+     */
+    explicit U128Array(std::span<const U128> values);
+
+    [[nodiscard]] std::size_t size() const noexcept { return mLow.size(); }
+    [[nodiscard]] bool empty() const noexcept { return mLow.empty(); }
+
+    void resize(std::size_t n);
+
+    [[nodiscard]] U128 operator[](std::size_t i) const noexcept { return U128{mLow[i], mHigh[i]}; }
+
+    void set(std::size_t i, const U128 &x) noexcept
+    {
+        mLow[i] = x.low();
+        mHigh[i] = x.high();
+    }
+
+    /**
+     * @brief Заменить содержимое копией последовательности.
+     */
+    void assign(std::span<const U128> values);
+
+    /**
+     * @brief Выгрузить числа в последовательность того же размера (SoA -> AoS).
+     */
+    void copy_to(std::span<U128> out) const noexcept;
+
+    /**
+     * @brief Массивы младших и старших половин.
+     */
+    [[nodiscard]] std::span<const u64> lows() const noexcept { return mLow; }
+    [[nodiscard]] std::span<const u64> highs() const noexcept { return mHigh; }
+    [[nodiscard]] std::span<u64> lows() noexcept { return mLow; }
+    [[nodiscard]] std::span<u64> highs() noexcept { return mHigh; }
+
+    /**
+     * @brief Поэлементные сложение и вычитание; размеры массивов должны совпадать.
+     */
+    U128Array &operator+=(const U128Array &other) noexcept;
+    U128Array &operator-=(const U128Array &other) noexcept;
+
+    /**
+     * @brief Поэлементное умножение на 64-битное число (младшие 128 бит произведения).
+     */
+    U128Array &operator*=(u64 m) noexcept;
+
+    /**
+     * @brief Поэлементные сдвиги на одинаковое число бит s < 128.
+     */
+    U128Array &operator<<=(u32 s) noexcept;
+    U128Array &operator>>=(u32 s) noexcept;
+
+    /**
+     * @brief Поэлементные минимум и максимум с другим массивом (результат - в этом массиве).
+     */
+    void min_with(const U128Array &other) noexcept;
+    void max_with(const U128Array &other) noexcept;
+
+    /**
+     * @brief Поэлементное сравнение: out[i] = 1, если this[i] < other[i], иначе 0.
+     * @param out Маска размера size().
+     */
+    void less(const U128Array &other, std::span<uint8_t> out) const noexcept;
+
+    /**
+     * @brief Сумма всех элементов без переполнения (256 бит).
+     */
+    [[nodiscard]] UBig<U128> sum() const noexcept;
+
+    /**
+     * @brief Используются ли ядра AVX2 на данном процессоре.
+     */
+    [[nodiscard]] static bool simd_enabled() noexcept;
+
+private:
+    Lane mLow;
+    Lane mHigh;
+};
+
+}
@@ -3,6 +3,7 @@
 #include "i128.hpp"
 #include "ecm_factorizer.h"
 
+#include <cmath>
 #include <list>
 #include <functional>
 #include <optional>
@@ -12,33 +13,36 @@ namespace u128::utils
 
 std::pair<U128, int> div_by_q(U128 &x, const U128& q)
 {
-    auto quotient = x / q;
-    auto remainder = x % q;
+    const Divider<U128> divider{q};
+    U128 remainder;
+    auto quotient = divider.divide(x, &remainder);
     int i = 0;
     while (remainder == 0)
     {
         i++;
         x = quotient;
-        quotient = x / q;
-        remainder = x % q;
+        quotient = divider.divide(x, &remainder);
     }
     return std::make_pair(U128{q}, i);
 }
 
 bool miller_test(U128 d, const U128& n)
 {
-    U128 x = get_random_value_ab(2, n - 2);
-    int_power_mod(x, d, n);
-    if ((x == 1) || (x == (n - 1)))
+    // Вычисления в форме Монтгомери: сравнение с 1 и n - 1 заменяется сравнением с их образами.
+    const Montgomery mont{n};
+    const U128 one = mont.one();
+    const U128 minus_one = n - one;
+    U128 x = mont.pow(mont.to(get_random_value_ab(2, n - 2)), d);
+    if ((x == one) || (x == minus_one))
         return true;
 
     while (d != (n - 1))
     {
-        int_power_mod(x, 2, n);
+        x = mont.sqr(x);
         d <<= 1;
-        if (x == 1)
+        if (x == one)
             return false;
-        if (x == (n - 1))
+        if (x == minus_one)
             return true;
     }
     return false;
@@ -99,13 +103,17 @@ std::pair<U128, U128> ferma_method(U128 x)
     const auto error = x - x_sqrt * x_sqrt;
     auto y = U128{2} * x_sqrt + U128{1} - error;
     {
-        bool is_exact;
-        auto y_sqrt = isqrt(y, is_exact);
+        U128 y_sqrt;
+        const bool is_exact = is_square(y, &y_sqrt);
         const auto delta = x_sqrt + x_sqrt + U128{3, 0};
         y += delta;
         if (is_exact)
             return std::make_pair(x_sqrt + U128{1} - y_sqrt, x_sqrt + U128{1} + y_sqrt);
     }
+    // Здесь y = (x_sqrt + k)^2 - x, приращение delta = 2*(x_sqrt + k) + 1, k = 2.
+    auto delta = (x_sqrt + x_sqrt) + U128{5, 0};
+    SquareSieve sieve{y, delta};
+    const bool x_is_odd = (x.low() & 1) == 1;
     const auto &k_upper = x_sqrt;
     for (U128 k = 2;; k++)
     {
@@ -113,38 +121,69 @@ std::pair<U128, U128> ferma_method(U128 x)
             break;
         if (k > k_upper)
             return std::make_pair(x, U128{1}); // x - простое число.
-        if ((k & 1) == 1)
+        if (x_is_odd && (k & 1) == 1)
         { // Проверка с другой стороны: ускоряет поиск.
             // Основано на равенстве, следующем из метода Ферма: индекс k = (F^2 + x) / (2F) - floor(sqrt(x)).
-            // Здесь F - кандидат в множители, x - раскладываемое число.
-            const auto N1 = k * k + x;
-            if ((N1.low() & 1) == 0)
-            {
-                const auto q1 = N1 / (k + k); // Здесь k как некоторый множитель F.
-                const auto remainder = N1 % (k + k);
-                if ((remainder == 0) && (q1 > x_sqrt))
-                {
-                    const auto q2 = x / k;
-                    const auto remainder = x % k;
-                    if (remainder == 0) // На всякий случай оставим.
-                        return std::make_pair(k, q2);
-                }
-            }
+            // Здесь F - кандидат в множители, x - раскладываемое число. Для нечетных x и F <= floor(sqrt(x))
+            // равенство выполняется ровно тогда, когда F делит x.
+            U128 remainder;
+            const auto q = U128::divide<true, true>(x, k, &remainder);
+            if (remainder == 0)
+                return std::make_pair(k, q);
+        }
+        if (U128 y_sqrt; sieve.maybe_square(y.low()) && is_square(y, &y_sqrt)) // Просеиваем заведомо лишние.
+        {
+            const auto first_multiplier = x_sqrt + k - y_sqrt;
+            if (first_multiplier == 1) // Тривиальное разложение 1 * x для малых x.
+                return std::make_pair(x, U128{1});
+            return std::make_pair(first_multiplier, x_sqrt + k + y_sqrt);
         }
-        if (const auto r = (y % 10u).low(); (r != 1 && r != 9)) // Просеиваем заведомо лишние.
-            continue;
-        bool is_exact;
-        const auto y_sqrt = isqrt(y, is_exact);
-        const auto delta = (x_sqrt + x_sqrt) + (k + k) + U128{1};
         y += delta;
-        if (!is_exact)
-            continue;
-        const auto first_multiplier = x_sqrt + k - y_sqrt;
-        return std::make_pair(first_multiplier, x_sqrt + k + y_sqrt);
+        delta += U128{2};
+        sieve.step();
     }
     return std::make_pair(x, U128{1}); // По какой-то причине не раскладывается.
 }
 
+std::pair<U128, U128> lehman_method(U128 x)
+{
+    assert(x.bit_width() <= LEHMAN_MAX_BITS);
+    const u64 n = x.low();
+    if (n < 4)
+        return std::make_pair(x, U128{1});
+    // 1. Пробное деление до кубического корня.
+    const u64 r = nroot(x, 3).low();
+    if ((n & 1) == 0)
+        return std::make_pair(U128{2}, U128{n >> 1});
+    for (u64 f = 3; f <= r; f += 2) {
+        if (n % f == 0)
+            return std::make_pair(U128{f}, U128{n / f});
+    }
+    // 2. Поиск представления a^2 - 4kn = b^2 для k <= n^{1/3},
+    // a на отрезке [sqrt(4kn), sqrt(4kn) + n^{1/6} / (4 sqrt(k))].
+    const double n_1_6 = std::pow(static_cast<double>(n), 1.0 / 6.0);
+    for (u64 k = 1; k <= r; ++k) {
+        if (((k & 4095) == 0) && Globals::LoadStop()) // Проверка на стоп через каждые 4096 отсчетов.
+            break;
+        const U128 four_kn = U128::mult_ext(k << 2, n);
+        bool is_exact;
+        U128 a = isqrt(four_kn, is_exact);
+        const U128 a_max = a + U128{1} + U128{static_cast<u64>(n_1_6 / (4.0 * std::sqrt(static_cast<double>(k))))};
+        if (!is_exact)
+            ++a;
+        U128 b2 = a * a - four_kn;
+        for (; a <= a_max; ++a) {
+            if (U128 b; is_square(b2, &b)) {
+                const U128 g = gcd(a + b, x);
+                if (g > 1 && g < x)
+                    return std::make_pair(g, x / g);
+            }
+            b2 += a + a + U128{1};
+        }
+    }
+    return std::make_pair(x, U128{1}); // x - простое число.
+}
+
 U128 ro_pollard(const U128& n, std::optional<U128> limit)
 {
     if (n < 4) return n;
@@ -206,15 +245,15 @@ std::map<U128, int> factor(U128 x)
         const U128 v_old = v;
         for (unsigned p = 2; p <= v.bit_width(); ++p)
         {
-            const U128 vr = nroot(v, p);
-            const auto x_r = int_power_fast(vr, p);
-            if (v == x_r)
+            U128 vr;
+            const bool is_power = (p == 2) ? is_square(v, &vr) : (vr = nroot(v, p), int_power_fast(vr, p) == v);
+            if (is_power)
             {
                 v = vr;
                 last_p = last_p == 0 ? p : last_p * p;
                 break;
             }
-            if (vr < 2)
+            if (p > 2 && vr < 2)
                 break;
         }
         if (v == v_old)
@@ -240,7 +279,7 @@ std::map<U128, int> factor(U128 x)
             return result;
         divisor += 2;
         for (;;) {
-            const auto& [d1, d2] = ferma_method(divisor);
+            const auto& [d1, d2] = lehman_method(divisor);
             if (d1 == divisor || d2 == divisor)
                 break;
             divisor += 2;
@@ -276,7 +315,7 @@ std::map<U128, int> factor(U128 x)
     if (x > 1)
         found_factors.push_back(x);
 
-    // Применяем метод Ферма рекурсивно.
+    // Применяем метод Ферма (Лемана для не слишком больших чисел) рекурсивно.
     std::function<void(U128)> ferma_recursive;
     ferma_recursive = [&ferma_recursive, &result, &last_p](U128 x) -> void
     {
@@ -284,7 +323,7 @@ std::map<U128, int> factor(U128 x)
             result[x] += last_p == 0 ? 1 : last_p;
             return;
         }
-        const auto& [a, b] = ferma_method(x);
+        const auto& [a, b] = x.bit_width() <= LEHMAN_MAX_BITS ? lehman_method(x) : ferma_method(x);
         if (a == U128{1})
         {
             result[b] += last_p == 0 ? 1 : last_p;
@@ -2,8 +2,13 @@
 
 #include "u128.hpp"
 #include "ubig.hpp"
+#include "mul_kernels.h"
+#include "prime_range.h"
 #include <_mingw_mac.h>
+#include <array>
 #include <atomic>
+#include <cmath>
+#include <limits>
 #include <map> // std::map
 #include <optional>
 #include <utility> // std::pair
@@ -47,35 +52,16 @@ U128 get_random_value_ab(const U128& a, const U128& b);
 U128 get_random_half_value();
 
 /**
- * @brief Sieve of Eratosthenes.
- * @param n
- * @return
+ * @brief Простые числа, не превосходящие n.
+ * Для потокового перебора больших диапазонов без хранения списка используйте PrimeRange.
+ * @param n Верхняя граница (включительно).
+ * @return Возрастающий список простых чисел.
  */
 inline std::vector<unsigned> primes(unsigned n) {
-    if (n < 2) return {};
-
     std::vector<unsigned> ps;
-    // Оценка количества простых (n/ln n) для reserve
-    ps.reserve(n / 6);
-
-    // Используем вектор bool (или uint8_t) только для нечетных чисел
-    std::vector<uint8_t> is_prime(n + 1, 1);
-
-    ps.push_back(2);
-
-    // Идем только по нечетным
-    for (unsigned p = 3; p <= n; p += 2) {
-        if (is_prime[p]) {
-            ps.push_back(p);
-
-            // Начинаем с p*p, шаг 2*p (чтобы попадать только на нечетные)
-            if (1ULL * p * p <= n) {
-                for (unsigned i = p * p; i <= n; i += 2 * p) {
-                    is_prime[i] = 0;
-                }
-            }
-        }
-    }
+    PrimeRange range{2, n};
+    for (const auto p : range)
+        ps.push_back(static_cast<unsigned>(p));
     return ps;
 }
 
@@ -104,7 +90,7 @@ inline void add_mod(U128& x, const U128& y, const U128& m)
     using namespace bignum;
     using U256 = UBig<U128>;
     auto z = U256{x} + U256{y};
-    x = (z / m).second;
+    x = z.divrem(m).second;
 }
 
 /**
@@ -117,7 +103,9 @@ inline void sub_mod(U128& x, const U128& y, const U128& m)
 {
     const bool is_normal = x >= y;
     const auto z = is_normal ? x - y : y - x;
-    x = is_normal ? z % m : m - (z % m);
+    // Для приведенных аргументов разность уже меньше модуля: деление не нужно.
+    const auto z_mod = z < m ? z : z % m;
+    x = is_normal ? z_mod : m - z_mod;
 }
 
 /**
@@ -130,8 +118,8 @@ inline void mult_mod(U128& x, const U128& y, const U128& m)
 {
     using namespace bignum;
     using U256 = UBig<U128>;
-    const U256 z = U256::mult_ext(x, y);
-    x = (z / m).second;
+    const U256 z = bignum::kernels::mul_kernels().mult_ext(x, y);
+    x = z.divrem(m).second;
 }
 
 /**
@@ -143,8 +131,8 @@ inline void square_mod(U128& x, const U128& m)
 {
     using namespace bignum;
     using U256 = UBig<U128>;
-    U256 z { U256::square_ext(x) };
-    x = (z / m).second;
+    U256 z { bignum::kernels::mul_kernels().square_ext(x) };
+    x = z.divrem(m).second;
 }
 
 /**
@@ -157,13 +145,13 @@ inline void square_add_mod(U128& x, const U128& y, const U128& m)
 {
     using namespace bignum;
     using U256 = UBig<U128>;
-    U256 z { U256::square_ext(x) };
+    U256 z { bignum::kernels::mul_kernels().square_ext(x) };
     if (x < U128::max()) {
         z += U256{y};
-        x = (z / m).second;
+        x = z.divrem(m).second;
     } else {
-        z = U256{(z / m).second} + U256{y};
-        x = (z / m).second;
+        z = U256{z.divrem(m).second} + U256{y};
+        x = z.divrem(m).second;
     }
 }
 
@@ -177,24 +165,111 @@ inline void mult_add_mod(U128& x, const U128& y, const U128& z, const U128& m)
 {
     using namespace bignum;
     using U256 = UBig<U128>;
-    U256 w { U256::mult_ext(x, y) };
+    U256 w { bignum::kernels::mul_kernels().mult_ext(x, y) };
     if (x < U128::max() || y < U128::max()) {
         w += U256{z};
-        x = (w / m).second;
+        x = w.divrem(m).second;
     } else {
-        w = U256{(w / m).second} + U256{z};
-        x = (w / m).second;
+        w = U256{w.divrem(m).second} + U256{z};
+        x = w.divrem(m).second;
     }
 }
 
 /**
- * @brief Степень числа по заданному модулю.
+ * @brief Арифметика Монтгомери по нечетному модулю n > 1, R = 2^128.
+ * Числа хранятся в форме x * R mod n; умножение обходится без деления 256/128,
+ * а ядра умножения и приведения выбираются по CPUID при загрузке библиотеки.
+ */
+class Montgomery
+{
+public:
+    /**
+     * @brief Конструктор. Требует двух делений для констант R mod n и R^2 mod n.
+     * @param n Нечетный модуль.
+     */
+    explicit Montgomery(const U128& n)
+        : mKernels{bignum::kernels::mul_kernels()}
+        , mN{n}
+    {
+        assert((n & 1) == 1 && n > 1);
+        // Обратный элемент по модулю 2^128 методом Ньютона: каждый шаг удваивает число верных битов (3 -> 192).
+        U128 inv = n;
+        for (int i = 0; i < 6; ++i)
+            inv *= U128{2} - n * inv;
+        mNInv = -inv;
+        mOne = (-n) % n;
+        mR2 = mOne;
+        mult_mod(mR2, mOne, n);
+    }
+
+    /**
+     * @brief Перевод в форму Монтгомери: x * R mod n.
+     */
+    U128 to(const U128& x) const {
+        return mul(x < mN ? x : x % mN, mR2);
+    }
+
+    /**
+     * @brief Обратный перевод: x * R^-1 mod n.
+     */
+    U128 from(const U128& x) const {
+        return mKernels.montgomery_redc(bignum::UBig<U128>{x}, mN, mNInv);
+    }
+
+    U128 mul(const U128& x, const U128& y) const {
+        return mKernels.montgomery_redc(mKernels.mult_ext(x, y), mN, mNInv);
+    }
+
+    U128 sqr(const U128& x) const {
+        return mKernels.montgomery_redc(mKernels.square_ext(x), mN, mNInv);
+    }
+
+    /**
+     * @brief Степень x^y; основание и результат в форме Монтгомери.
+     */
+    U128 pow(U128 x, U128 y) const {
+        U128 result = mOne;
+        while (y != 0) {
+            if ((y & 1) == 1)
+                result = mul(result, x);
+            y >>= 1;
+            x = sqr(x);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Единица в форме Монтгомери (R mod n).
+     */
+    const U128& one() const {
+        return mOne;
+    }
+
+    const U128& modulus() const {
+        return mN;
+    }
+
+private:
+    const bignum::kernels::MulKernels& mKernels;
+    U128 mN;
+    U128 mNInv;
+    U128 mOne;
+    U128 mR2;
+};
+
+/**
+ * @brief Степень числа по заданному модулю. Для нечетного модуля - в форме Монтгомери.
  * @param x Основание степени. Сюда кладется результат (x^y) mod m.
  * @param y Степень.
  * @param m Модуль.
  */
 inline void int_power_mod(U128& x, const U128& y, const U128& m)
 {
+    if ((m & 1) == 1 && m > 1) {
+        const Montgomery mont{m};
+        x = mont.from(mont.pow(mont.to(x), y));
+        return;
+    }
     U128 exponent = y;
     U128 base = x;
     x = 1;
@@ -228,45 +303,200 @@ inline U128 int_power_fast(U128 x, unsigned y) noexcept
     return result;
 }
 
+/**
+ * @brief Приближенное значение числа в формате long double.
+ */
+inline long double to_long_double(const U128& x)
+{
+    return static_cast<long double>(x.high()) * 0x1p64L + static_cast<long double>(x.low());
+}
+
+/**
+ * @brief Возведение в степень с контролем переполнения.
+ * @return Да, если x^y не превосходит limit.
+ */
+inline bool int_power_not_greater(const U128& x, unsigned y, const U128& limit)
+{
+    if (y == 0 || x <= 1)
+        return int_power_fast(x, y) <= limit;
+    const unsigned bits = x.bit_width();
+    if (y * bits <= 128) // Переполнение невозможно.
+        return int_power_fast(x, y) <= limit;
+    if (y * (bits - 1) >= 128) // x^y >= 2^128.
+        return false;
+    using U256 = bignum::UBig<U128>;
+    U128 result{1};
+    for (unsigned i = 0; i < y; ++i) {
+        const U256 z = U256::mult_ext(result, x);
+        if (z.high() != 0)
+            return false;
+        result = z.low();
+    }
+    return result <= limit;
+}
+
 /**
  * @brief Целочисленный квадратный корень sqrt(x).
+ * Начальное приближение берется из аппаратного sqrt над long double,
+ * затем уточняется не более чем двумя целочисленными поправками.
  * @param exact Возвращает true, если x — полный квадрат.
  */
 inline U128 isqrt(const U128& x, bool& exact)
 {
-    if (x == 0) {
-        exact = true;
-        return 0;
+    const long double sf = std::sqrt(to_long_double(x));
+    U128 s = sf >= 0x1p64L ? U128{~0ull} : U128{static_cast<u64>(sf)};
+    if constexpr (std::numeric_limits<long double>::digits < 64) {
+        // long double совпадает с double (MSVC): один шаг Ньютона доводит ошибку до единицы.
+        if (s != 0)
+            s = (s + x / s) >> 1;
+    }
+    while (s * s > x)
+        --s;
+    while (s.low() != ~0ull && (s + 1) * (s + 1) <= x)
+        ++s;
+    exact = (s * s == x);
+    return s;
+}
+
+// Перегрузка для удобства
+inline U128 isqrt(const U128& x) {
+    bool dummy;
+    return isqrt(x, dummy);
+}
+
+/**
+ * @brief Целочисленный квадратный корень 256-битного числа, floor(sqrt(x)).
+ * Начальное приближение - корень старших 128 бит, взятый с запасом вверх; затем шаги Ньютона
+ * с делением 256/128, которые от верхней оценки сходятся монотонно (обычно за один-два шага).
+ * @param remainder Остаток x - root^2 (может быть nullptr): ноль, если x - полный квадрат.
+ */
+inline U128 isqrt(const bignum::UBig<U128>& x, bignum::UBig<U128>* remainder = nullptr)
+{
+    using U256 = bignum::UBig<U128>;
+    U128 s;
+    if (x.high() == 0) {
+        s = isqrt(x.low());
+    } else {
+        const uint32_t k = (256 - x.countl_zero() - 126) / 2;
+        const U256 upper = U256{isqrt((x >> (2 * k)).low()) + U128{1}} << k;
+        s = upper.high() == 0 ? upper.low() : U128::max();
+        for (;;) {
+            const U256 next = (U256{s} + x.divrem(s).first) >> 1;
+            if (next.high() != 0 || next.low() >= s)
+                break;
+            s = next.low();
+        }
     }
+    if (remainder)
+        *remainder = x - U256::square_ext(s);
+    return s;
+}
 
-    // Начальное приближение: 2^(ceil(bits/2))
-    U128 x0 = U128{1} << ((x.bit_width() + 1) / 2);
-    U128 x1;
+/**
+ * @brief Таблица квадратичных вычетов по модулю M: SQUARE_RESIDUES<M>[r] <=> r = y^2 mod M для некоторого y.
+ */
+template <unsigned M>
+inline constexpr auto SQUARE_RESIDUES = [] {
+    std::array<bool, M> table{};
+    for (unsigned y = 0; y < M; ++y)
+        table[(y * y) % M] = true;
+    return table;
+}();
 
-    for (;;) {
-        U128 remainder;
-        // ОПТИМИЗАЦИЯ: Получаем частное и остаток за один проход
-        U128 quotient = U128::divide<true, true>(x, x0, &remainder);
+/**
+ * @brief Фильтр полных квадратов для последовательности метода Ферма:
+ * y_{k+1} = y_k + d_k, d_{k+1} = d_k + 2.
+ * Вычеты по малым модулям обновляются без делений. Вместе с проверкой по модулю 64
+ * отсеивает около 99.9% неквадратов до вызова isqrt.
+ */
+class SquareSieve {
+    static constexpr std::array<unsigned, 6> MODULI {63, 65, 11, 17, 19, 23};
 
-        x1 = (x0 + quotient) >> 1;
+    static constexpr std::array<const bool*, 6> TABLES {
+        SQUARE_RESIDUES<63>.data(), SQUARE_RESIDUES<65>.data(), SQUARE_RESIDUES<11>.data(),
+        SQUARE_RESIDUES<17>.data(), SQUARE_RESIDUES<19>.data(), SQUARE_RESIDUES<23>.data()};
 
-        // В целочисленном методе Ньютона x1 >= x0 означает сходимость к floor(sqrt)
-        if (x1 >= x0) {
-            exact = (x0 * x0 == x);
-            return x0;
+    /**
+     * @brief Вычеты текущего значения y.
+     */
+    std::array<unsigned, 6> mY;
+
+    /**
+     * @brief Вычеты текущего приращения d.
+     */
+    std::array<unsigned, 6> mD;
+public:
+    /**
+     * @brief Конструктор.
+     * @param y Начальное значение последовательности.
+     * @param d Начальное приращение.
+     */
+    SquareSieve(const U128& y, const U128& d) {
+        for (size_t i = 0; i < MODULI.size(); ++i) {
+            mY[i] = static_cast<unsigned>((y % MODULI[i]).low());
+            mD[i] = static_cast<unsigned>((d % MODULI[i]).low());
         }
-        x0 = x1;
     }
-}
 
-// Перегрузка для удобства
-inline U128 isqrt(const U128& x) {
-    bool dummy;
-    return isqrt(x, dummy);
+    /**
+     * @brief Может ли текущее значение y быть полным квадратом.
+     * @param y_low Младшие 64 бита текущего y (для проверки по модулю 64).
+     */
+    bool maybe_square(u64 y_low) const {
+        if (!SQUARE_RESIDUES<64>[y_low & 63])
+            return false;
+        for (size_t i = 0; i < MODULI.size(); ++i)
+            if (!TABLES[i][mY[i]])
+                return false;
+        return true;
+    }
+
+    /**
+     * @brief Перейти к следующему члену последовательности.
+     */
+    void step() {
+        for (size_t i = 0; i < MODULI.size(); ++i) {
+            mY[i] += mD[i];
+            if (mY[i] >= MODULI[i])
+                mY[i] -= MODULI[i];
+            mD[i] += 2;
+            if (mD[i] >= MODULI[i])
+                mD[i] -= MODULI[i];
+        }
+    }
+};
+
+/**
+ * @brief Является ли число полным квадратом.
+ * Неквадраты отсеиваются по вычетам mod 64, 63, 65 и 11 (остается около 0.8% чисел).
+ * Для оставшихся корень вычисляется через isqrt (оценка long double и целочисленное уточнение).
+ * @param x Проверяемое число.
+ * @param root Сюда кладется корень, если x - полный квадрат (может быть nullptr).
+ * @return Да/нет.
+ */
+inline bool is_square(const U128& x, U128* root = nullptr)
+{
+    if (!SQUARE_RESIDUES<64>[x.low() & 63])
+        return false;
+    // Остаток по модулю 63 * 65 * 11 из двух 64-битных половин: 2^64 mod M заранее известен.
+    constexpr u64 M = 63 * 65 * 11;
+    constexpr u64 TWO_64_MOD_M = (U128{0, 1} % U128{M}).low();
+    const u64 r = ((x.high() % M) * TWO_64_MOD_M + x.low() % M) % M;
+    if (!SQUARE_RESIDUES<63>[r % 63] || !SQUARE_RESIDUES<65>[r % 65] || !SQUARE_RESIDUES<11>[r % 11])
+        return false;
+    bool exact;
+    const U128 s = isqrt(x, exact);
+    if (!exact)
+        return false;
+    if (root)
+        *root = s;
+    return true;
 }
 
 /**
  * @brief Целочисленный корень m-й степени из x.
+ * Начальное приближение берется из cbrt/pow над double,
+ * затем уточняется целочисленно с проверкой переполнения (int_power_not_greater).
  */
 inline U128 nroot(const U128& x, unsigned m)
 {
@@ -275,48 +505,16 @@ inline U128 nroot(const U128& x, unsigned m)
     if (m >= 128) return (x > 0) ? U128{1} : U128{0};
     if (m == 2) return isqrt(x);
 
-    // 1. Начальное приближение "сверху"
-    // Берем 2^(ceil(bit_width / m))
-    uint32_t target_bits = (x.bit_width() + m - 1) / m;
-    U128 x0 = U128{1} << target_bits;
-
-    // Страховка: если 2^target_bits оказался больше x
-    if (x0 > x) x0 = x;
-
-    U128 m_val{m};
-    [[maybe_unused]] U128 m_minus_1 = m_val - 1;
+    // При m >= 3 корень меньше 2^43: точности double хватает, чтобы ошибиться не более чем на единицу.
+    const double xf = static_cast<double>(to_long_double(x));
+    const double rf = (m == 3) ? std::cbrt(xf) : std::pow(xf, 1.0 / m);
+    U128 r{static_cast<u64>(rf)};
 
-    for (;;) {
-        U128 p = int_power_fast(x0, m - 1);
-        U128 quotient = (p == 0) ? U128{0} : (x / p);
-
-        // Стандартная формула Ньютона: x1 = ((m-1)*x0 + quotient) / m
-        // Чтобы избежать переполнения (m-1)*x0, считаем через разность:
-        U128 x1;
-        if (x0 > quotient) {
-            // Идем вниз: x1 = x0 - (x0 - quotient) / m
-            U128 diff = (x0 - quotient) / m_val;
-
-            // КРИТИЧЕСКИЙ МОМЕНТ: если diff == 0, но x0 > quotient,
-            // это не значит, что мы на месте. Это значит, что шаг < 1.
-            // В целых числах нам нужно принудительно сделать шаг -1.
-            if (diff == 0) x1 = x0 - 1;
-            else x1 = x0 - diff;
-        } else {
-            // Если x0 <= quotient, мы либо нашли корень, либо зашли снизу.
-            // Метод Ньютона сверху вниз гарантирует, что x0 >= floor(root).
-            return x0;
-        }
-
-        // Если x1 перелетел через корень (стал слишком маленьким)
-        // или если мы начали расти — останавливаемся.
-        if (x1 >= x0) return x0;
-
-        // Проверка: не стал ли x1^m меньше x?
-        // Если стал — значит x1 и есть наш floor(root).
-        // Но проще довериться сходимости и сделать еще одну итерацию.
-        x0 = x1;
-    }
+    while (!int_power_not_greater(r, m, x))
+        --r;
+    while (int_power_not_greater(r + 1, m, x))
+        ++r;
+    return r;
 }
 
 bool miller_test(U128 d, const U128 &n);
@@ -326,15 +524,9 @@ bool miller_test(U128 d, const U128 &n);
  * @param x Число.
  * @return Количество цифр, минимум 1.
  */
-inline int num_of_digits(U128 x)
+inline int num_of_digits(const U128& x)
 {
-    int i = 0;
-    while (x != 0)
-    {
-        x /= 10u;
-        i++;
-    }
-    return i + (i == 0);
+    return digits10(x);
 }
 
 /**
@@ -429,6 +621,18 @@ std::pair<U128, int> div_by_q(U128 &x, const U128& q);
  */
 std::pair<U128, U128> ferma_method(U128 x);
 
+/**
+ * @brief Наибольшая разрядность числа для метода Лемана.
+ */
+inline constexpr unsigned LEHMAN_MAX_BITS = 64;
+
+/**
+ * @brief Метод факторизации Лемана: O(x^{1/3}) независимо от соотношения множителей.
+ * @param x Факторизуемое число, не более LEHMAN_MAX_BITS бит.
+ * @return Два множителя; {x, 1}, если x - простое число.
+ */
+std::pair<U128, U128> lehman_method(U128 x);
+
 /**
  * @brief Алгоритм ро Полларда.
  * @param n Факторизуемое число.
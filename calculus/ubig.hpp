@@ -10,6 +10,7 @@
 #include <compare>
 #include <algorithm>
 #include <utility>
+#include <type_traits>
 #include "u128.hpp" // generic
 
 namespace bignum
@@ -473,6 +474,60 @@ public:
         return {Q, R};
     }
 
+    /**
+         * @brief Деление 256/128: алгоритм D Кнута по 64-битным словам с нормализацией,
+         * где оценка очередного слова частного дается делением 2/1 или 3/2 слова
+         * через обратную величину делителя (без аппаратного деления).
+         * @param d Делитель с предвычисленной обратной величиной; выгоден при многократном делении на одно число.
+         * @return {Частное Q, Остаток R}.
+         */
+    constexpr std::pair<UBig, ULOW> divrem(const bignum::u128::Divider<ULOW> &d) const noexcept
+        requires std::is_same_v<ULOW, bignum::u128::U128>
+    {
+        using bignum::u128::u64;
+        assert(d.divisor() != ULOW{0});
+
+        // Быстрый путь: делимое узкое, достаточно деления 128/128.
+        if (mHigh == ULOW{0})
+        {
+            ULOW r;
+            const ULOW q = d.divide(mLow, &r);
+            return {UBig{q}, r};
+        }
+
+        // Нормализованное делимое: пять слов n[4]..n[0].
+        const uint32_t s = d.shift();
+        const UBig N = *this << s;
+        const u64 n4 = (s == 0) ? 0 : mHigh.high() >> (64 - s);
+        const u64 n[4] = {N.mLow.low(), N.mLow.high(), N.mHigh.low(), N.mHigh.high()};
+        // Быстрый путь: старшая половина меньше делителя, тогда частное умещается в 128 бит
+        // и старшие шаги деления пропускаются.
+        const bool short_quotient = mHigh < d.divisor();
+
+        u64 q[4] = {0, 0, 0, 0};
+        if (d.divisor().high() == 0)
+        {
+            const u64 dn = d.normalized().low();
+            u64 r = short_quotient ? n[2] : n4;
+            for (int i = short_quotient ? 1 : 3; i >= 0; --i)
+                q[i] = bignum::u128::div_2by1(r, n[i], dn, d.reciprocal(), r);
+            return {UBig{ULOW{q[0], q[1]}, ULOW{q[2], q[3]}}, ULOW{r >> s}};
+        }
+        ULOW r = short_quotient ? ULOW{n[2], n[3]} : ULOW{n[3], n4};
+        for (int i = short_quotient ? 1 : 2; i >= 0; --i)
+            q[i] = bignum::u128::div_3by2(r.high(), r.low(), n[i], d.normalized(), d.reciprocal(), r);
+        return {UBig{ULOW{q[0], q[1]}, ULOW{q[2], 0}}, r >> s};
+    }
+
+    /**
+         * @brief Деление 256/128 на произвольный делитель; см. divrem(const Divider&).
+         */
+    constexpr std::pair<UBig, ULOW> divrem(const ULOW &d) const noexcept
+        requires std::is_same_v<ULOW, bignum::u128::U128>
+    {
+        return divrem(bignum::u128::Divider<ULOW>{d});
+    }
+
     /**
          * @brief Количество ведущих нулей.
          */
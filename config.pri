@@ -1,5 +1,12 @@
 # You can define W2, W3, W4 digits after the comma
 # DEFINES += PRECISION_W3
 # Or even another if modify decimal.h
+# A compile-time width needs no define: use dec_n::FixedDecimal<W> from scaled_decimal.h
+
+# Compact two's-complement S128 as the Decimal backing type (magnitude up to 2^127)
+# DEFINES += DECIMAL_S128
+
+# Print ns/op benchmarks (I128 vs S128, Decimal arithmetic) at startup
+# DEFINES += RUN_BENCHMARKS
 
 # Don't forget tune main.qml to appropriate precision W, see RegExpValidator